@@ -0,0 +1,19 @@
+#ifndef AFTERHOOK_H
+#define AFTERHOOK_H
+#include "inlinefunction.h"
+#include "response.h"
+#include "request.h"
+
+/**
+ * @brief A function that runs after the response function and can modify its response.
+ *
+ * Registered with `Middleware::pushAfter`. Plain functions, lambdas with captures and functors are
+ * stored without heap allocation (see InlineFunction):
+ * @code
+ * Middleware api;
+ * api.pushAfter([](Request& req, Response& res){ res.setContentType("application/json"); });
+ * @endcode
+ */
+using AfterHook = InlineFunction<void(Request&, Response&)>;
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef BODYGENERATOR_H
+#define BODYGENERATOR_H
+#include <cstddef>
+#include "inlinefunction.h"
+
+/**
+ * @brief A function that produces a response body piece by piece, when its length is not known in advance.
+ *
+ * The server calls it repeatedly with a buffer to fill, and sends every piece as one chunk of a
+ * `Transfer-Encoding: chunked` response. It returns the number of bytes it wrote, at most
+ * `capacity`, and 0 once the body is complete:
+ * @code
+ * int remaining = 1000;
+ * res.setContentGenerator([remaining](char* buffer, std::size_t capacity) mutable -> std::size_t {
+ *     if(remaining == 0) return 0;
+ *     remaining--;
+ *     return std::snprintf(buffer, capacity, "line %d\n", remaining);
+ * });
+ * @endcode
+ */
+using BodyGenerator = InlineFunction<std::size_t(char* buffer, std::size_t capacity)>;
+
+#endif
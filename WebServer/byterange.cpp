@@ -0,0 +1,147 @@
+#include "byterange.h"
+#include "httpheader.h"
+#include <algorithm>
+#include <charconv>
+
+/**
+ * @brief Removes leading and trailing spaces and tabs.
+ */
+static std::string_view trim(std::string_view text){
+    while(!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while(!text.empty() && (text.back() == ' ' || text.back() == '\t')) text.remove_suffix(1);
+    return text;
+}
+
+/**
+ * @brief Parses a decimal number that makes up all of the text.
+ *
+ * @param text The digits.
+ * @param value Set to the number.
+ * @return False if the text is empty, not a number or too large.
+ */
+static bool parseNumber(std::string_view text, std::uint64_t &value){
+    if(text.empty()) return false;
+    std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+/**
+ * @brief Parses the `Range` header of a request, e.g. "bytes=0-499, -500".
+ *
+ * Each range is resolved against the size of the representation: "500-" is everything from byte
+ * 500 on, "-500" the last 500 bytes, and a last position beyond the end is cut off. Ranges that
+ * start beyond the end are dropped. A header in another unit, with a syntax error or with more than
+ * maxByteRanges ranges is ignored, as RFC 9110 allows. The unit is compared ignoring case.
+ *
+ * @param rangeHeader The value of the `Range` header.
+ * @param size The size of the representation.
+ * @param ranges Set to the satisfiable ranges, in the order of the header.
+ * @return Whether the ranges can be served.
+ */
+RangeStatus parseByteRanges(std::string_view rangeHeader, std::uint64_t size, std::vector<ByteRange> &ranges){
+    ranges.clear();
+    rangeHeader = trim(rangeHeader);
+    if(rangeHeader.size() < 6 || !HttpHeader::equals(rangeHeader.substr(0, 6), "bytes=")) return RANGE_IGNORED;
+    rangeHeader.remove_prefix(6);
+
+    std::size_t rangeCount = 0;
+    while(!rangeHeader.empty()){
+        std::size_t comma = rangeHeader.find(',');
+        std::string_view rangeSpec = trim(rangeHeader.substr(0, comma));
+        rangeHeader = (comma == std::string_view::npos) ? std::string_view() : rangeHeader.substr(comma + 1);
+        if(rangeSpec.empty()) continue;
+        if(++rangeCount > maxByteRanges) return RANGE_IGNORED;
+
+        std::size_t dash = rangeSpec.find('-');
+        if(dash == std::string_view::npos) return RANGE_IGNORED;
+        std::string_view firstText = trim(rangeSpec.substr(0, dash));
+        std::string_view lastText = trim(rangeSpec.substr(dash + 1));
+
+        ByteRange range;
+        std::uint64_t first, last;
+        if(firstText.empty()){
+            // A suffix range, the last bytes of the representation
+            std::uint64_t suffixLength;
+            if(!parseNumber(lastText, suffixLength)) return RANGE_IGNORED;
+            if(suffixLength == 0 || size == 0) continue;
+            range.length = std::min(suffixLength, size);
+            range.offset = size - range.length;
+        }
+        else{
+            if(!parseNumber(firstText, first)) return RANGE_IGNORED;
+            if(lastText.empty()) last = UINT64_MAX;
+            else if(!parseNumber(lastText, last) || last < first) return RANGE_IGNORED;
+            if(first >= size) continue;
+            range.offset = first;
+            range.length = std::min(last, size - 1) - first + 1;
+        }
+        ranges.push_back(range);
+    }
+    if(rangeCount == 0) return RANGE_IGNORED;
+    return ranges.empty() ? RANGE_NOT_SATISFIABLE : RANGE_SATISFIABLE;
+}
+
+/**
+ * @brief Appends a number in decimal.
+ */
+static void appendNumber(std::string &output, std::uint64_t value){
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    output.append(digits, result.ptr - digits);
+}
+
+/**
+ * @brief Formats the value of a `Content-Range` header, e.g. "bytes 0-499/1234".
+ *
+ * @param range The range.
+ * @param size The size of the representation.
+ * @return The header value.
+ */
+std::string formatContentRange(const ByteRange &range, std::uint64_t size){
+    std::string contentRange;
+    contentRange.reserve(72);
+    contentRange.append("bytes ");
+    appendNumber(contentRange, range.offset);
+    contentRange.push_back('-');
+    appendNumber(contentRange, range.offset + range.length - 1);
+    contentRange.push_back('/');
+    appendNumber(contentRange, size);
+    return contentRange;
+}
+
+/**
+ * @brief Formats the delimiter and header of one part of a `multipart/byteranges` body.
+ *
+ * @param part The index of the part, `ranges.size()` for the closing delimiter.
+ * @param ranges The ranges of the body.
+ * @param size The size of the representation.
+ * @param contentType The content type of the representation.
+ * @param boundary The boundary between the parts.
+ * @return The bytes that precede the range of the part, or the closing delimiter.
+ */
+std::string formatMultipartHeader(std::size_t part, const std::vector<ByteRange> &ranges, std::uint64_t size, std::string_view contentType, std::string_view boundary){
+    std::string header;
+    header.append(part == 0 ? "--" : "\r\n--").append(boundary.data(), boundary.size());
+    if(part == ranges.size()) return header.append("--\r\n");
+    header.append("\r\nContent-Type: ").append(contentType.data(), contentType.size());
+    header.append("\r\nContent-Range: ").append(formatContentRange(ranges[part], size)).append("\r\n\r\n");
+    return header;
+}
+
+/**
+ * @brief Computes the length of a `multipart/byteranges` body, so it can be sent with a `Content-Length`.
+ *
+ * @param ranges The ranges of the body.
+ * @param size The size of the representation.
+ * @param contentType The content type of the representation.
+ * @param boundary The boundary between the parts.
+ * @return The length of the part headers, the ranges and the closing delimiter together.
+ */
+std::uint64_t multipartByteRangesLength(const std::vector<ByteRange> &ranges, std::uint64_t size, std::string_view contentType, std::string_view boundary){
+    std::uint64_t length = 0;
+    for(std::size_t part = 0; part <= ranges.size(); part++){
+        length += formatMultipartHeader(part, ranges, size, contentType, boundary).size();
+        if(part < ranges.size()) length += ranges[part].length;
+    }
+    return length;
+}
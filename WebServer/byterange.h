@@ -0,0 +1,41 @@
+#ifndef BYTERANGE_H
+#define BYTERANGE_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "fileregion.h"
+#include "bodygenerator.h"
+
+/**
+ * @brief A range of bytes of a representation, resolved against its size.
+ */
+struct ByteRange {
+    std::uint64_t offset = 0;
+    std::uint64_t length = 0;
+};
+
+/**
+ * @brief The outcome of parsing a `Range` header.
+ */
+enum RangeStatus {
+    RANGE_IGNORED,              ///< No usable byte ranges, the whole representation is sent with 200
+    RANGE_SATISFIABLE,          ///< At least one range overlaps the representation, it is sent with 206
+    RANGE_NOT_SATISFIABLE       ///< No range overlaps the representation, 416 is sent
+};
+
+/*
+ * The parser and formatter do not touch files. makeMultipartByteRanges reads the file as the body
+ * is sent and is defined in byterangefile.cpp, apart from them.
+ */
+
+const std::size_t maxByteRanges = 16;    ///< Requests for more ranges are answered with the whole representation
+
+RangeStatus parseByteRanges(std::string_view rangeHeader, std::uint64_t size, std::vector<ByteRange>& ranges);
+std::string formatContentRange(const ByteRange& range, std::uint64_t size);
+std::string formatMultipartHeader(std::size_t part, const std::vector<ByteRange>& ranges, std::uint64_t size, std::string_view contentType, std::string_view boundary);
+std::uint64_t multipartByteRangesLength(const std::vector<ByteRange>& ranges, std::uint64_t size, std::string_view contentType, std::string_view boundary);
+BodyGenerator makeMultipartByteRanges(const FileRegion& fileRegion, const std::vector<ByteRange>& ranges, std::string_view contentType, std::string_view boundary);
+
+#endif
@@ -0,0 +1,84 @@
+#include "byterange.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+/**
+ * @brief The state of a multipart/byteranges body while it is generated.
+ *
+ * The body is a sequence of segments: the header of each part followed by its range of the file,
+ * and the closing delimiter.
+ */
+struct MultipartByteRanges {
+    FileRegion fileRegion;
+    std::vector<ByteRange> ranges;
+    std::vector<std::string> partHeaders;   ///< One per range, the last entry is the closing delimiter
+    std::size_t part = 0;                   ///< The part being written
+    std::uint64_t position = 0;             ///< The position within the header or range of that part
+    bool inHeader = true;
+
+    std::size_t generate(char* buffer, std::size_t capacity);
+};
+
+/**
+ * @brief Writes the next bytes of the body.
+ *
+ * @param buffer The buffer to write to.
+ * @param capacity The size of the buffer.
+ * @return The number of bytes written, 0 at the end of the body.
+ */
+std::size_t MultipartByteRanges::generate(char *buffer, std::size_t capacity){
+    std::size_t written = 0;
+    while(written < capacity && part < partHeaders.size()){
+        if(inHeader){
+            const std::string& header = partHeaders[part];
+            std::size_t count = std::min<std::size_t>(header.size() - position, capacity - written);
+            std::memcpy(buffer + written, header.data() + position, count);
+            written += count;
+            position += count;
+            if(position < header.size()) continue;
+            position = 0;
+            if(part == ranges.size()){
+                part++;     // The closing delimiter has been written
+                continue;
+            }
+            inHeader = false;
+        }
+        const ByteRange& range = ranges[part];
+        std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(range.length - position, capacity - written));
+        std::size_t bytesRead = fileRegion.read(range.offset + position, buffer + written, count);
+        if(bytesRead == 0) return written;     // The file was truncated, end the body
+        written += bytesRead;
+        position += bytesRead;
+        if(position == range.length){
+            position = 0;
+            inHeader = true;
+            part++;
+        }
+    }
+    return written;
+}
+
+/**
+ * @brief Creates a generator for a `multipart/byteranges` body with several ranges of a file.
+ *
+ * Every part carries the content type of the file and its own `Content-Range`. The file is read in
+ * pieces as the body is sent, it is never held in memory. The body has the length computed by
+ * multipartByteRangesLength, unless the file is truncated while it is sent.
+ *
+ * @param fileRegion The whole file.
+ * @param ranges The ranges, resolved with parseByteRanges.
+ * @param contentType The content type of the file.
+ * @param boundary The boundary between the parts, which is also set in the `Content-Type` of the response.
+ * @return The generator.
+ */
+BodyGenerator makeMultipartByteRanges(const FileRegion &fileRegion, const std::vector<ByteRange> &ranges, std::string_view contentType, std::string_view boundary){
+    std::shared_ptr<MultipartByteRanges> body = std::make_shared<MultipartByteRanges>();
+    body->fileRegion = fileRegion;
+    body->ranges = ranges;
+    body->partHeaders.reserve(ranges.size() + 1);
+    for(std::size_t part = 0; part <= ranges.size(); part++){
+        body->partHeaders.push_back(formatMultipartHeader(part, ranges, fileRegion.getLength(), contentType, boundary));
+    }
+    return [body](char* buffer, std::size_t capacity){ return body->generate(buffer, capacity); };
+}
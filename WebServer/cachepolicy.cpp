@@ -0,0 +1,52 @@
+#include "cachepolicy.h"
+#include "response.h"
+
+/**
+ * @brief Creates a policy with a custom `Cache-Control` value.
+ *
+ * @param cacheControl The header value, e.g. "private, max-age=60". Empty to send no header.
+ */
+CachePolicy::CachePolicy(const std::string &cacheControl): cacheControl(cacheControl) {}
+
+/**
+ * @brief Clients may store the files but must revalidate them before every use.
+ *
+ * Revalidation is cheap, an unchanged file is answered with 304 Not Modified.
+ */
+CachePolicy CachePolicy::noCache(){
+    return CachePolicy("no-cache");
+}
+
+/**
+ * @brief Clients must not store the files at all.
+ */
+CachePolicy CachePolicy::noStore(){
+    return CachePolicy("no-store");
+}
+
+/**
+ * @brief Clients may use the files without revalidating them for a while.
+ *
+ * @param seconds How long a file stays fresh.
+ */
+CachePolicy CachePolicy::maxAge(std::uint32_t seconds){
+    return CachePolicy("public, max-age=" + std::to_string(seconds));
+}
+
+/**
+ * @brief Clients may use the files for a year without ever revalidating them.
+ *
+ * Only suitable for URLs whose content never changes, such as fingerprinted asset URLs.
+ */
+CachePolicy CachePolicy::immutable(){
+    return CachePolicy("public, max-age=" + std::to_string(oneYear) + ", immutable");
+}
+
+/**
+ * @brief Sets the `Cache-Control` header of a response, unless the policy sends none.
+ *
+ * @param response The response.
+ */
+void CachePolicy::apply(Response &response) const{
+    if(!cacheControl.empty()) response.setHeader(HttpHeader::CACHE_CONTROL, cacheControl);
+}
@@ -0,0 +1,37 @@
+#ifndef CACHEPOLICY_H
+#define CACHEPOLICY_H
+#include <cstdint>
+#include <string>
+
+class Response;
+
+/**
+ * @brief How long clients may cache the files of a static mount, sent as the `Cache-Control` header.
+ *
+ * @code
+ * server.mountStatic("/static/css/", "/static/css/", CachePolicy::maxAge(3600), true);
+ * server.mountStatic("/downloads/", "/files/", CachePolicy::noCache());
+ * @endcode
+ * Fingerprinted asset URLs are always served with immutable(), see StaticMount.
+ */
+class CachePolicy{
+private:
+    std::string cacheControl;       ///< The value of the `Cache-Control` header, empty to send none
+
+public:
+    static const std::uint32_t oneYear = 31536000;     ///< The longest max-age caches are expected to honour
+
+    CachePolicy() = default;
+    explicit CachePolicy(const std::string& cacheControl);
+
+    static CachePolicy noCache();
+    static CachePolicy noStore();
+    static CachePolicy maxAge(std::uint32_t seconds);
+    static CachePolicy immutable();
+
+    void apply(Response& response) const;
+
+    const std::string& getCacheControl() const { return cacheControl; }
+};
+
+#endif
@@ -0,0 +1,95 @@
+#include "contentencoding.h"
+#include "httpheader.h"
+#include <algorithm>
+#include <cctype>
+
+/**
+ * @brief Parses a quality value of `Accept-Encoding`, e.g. "0.8", in thousandths.
+ *
+ * @param value The value after "q=".
+ * @return The quality from 0 to 1000.
+ */
+static int parseQuality(std::string_view value){
+    int quality = 0;
+    std::size_t i = 0;
+    if(i < value.size() && value[i] == '1') quality = 1000;
+    if(i < value.size() && (value[i] == '0' || value[i] == '1')) i++;
+    if(i < value.size() && value[i] == '.'){
+        int scale = 100;
+        for(i++; i < value.size() && scale > 0 && std::isdigit(static_cast<unsigned char>(value[i])); i++, scale /= 10){
+            quality += (value[i] - '0') * scale;
+        }
+    }
+    return std::min(quality, 1000);
+}
+
+/**
+ * @brief Removes leading and trailing spaces and tabs.
+ */
+static std::string_view trim(std::string_view text){
+    while(!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while(!text.empty() && (text.back() == ' ' || text.back() == '\t')) text.remove_suffix(1);
+    return text;
+}
+
+/**
+ * @brief Picks the encoding of a response from the request's `Accept-Encoding` header.
+ *
+ * Of the available encodings the client accepts, the one with the highest quality value is
+ * picked, preferring br, then gzip, then deflate if they are equal. An encoding is accepted if it
+ * is listed, or matched by `*`, with a quality above 0.
+ *
+ * @param acceptEncoding The header value, e.g. "gzip, deflate, br;q=0.9".
+ * @param availableEncodings Per encoding, whether the response can be sent in it.
+ * @return The encoding, ENCODING_IDENTITY if none of the available encodings is accepted.
+ */
+ContentEncoding negotiateContentEncoding(std::string_view acceptEncoding, const bool (&availableEncodings)[ENCODING_COUNT]){
+    int qualities[ENCODING_COUNT] = {-1, -1, -1, -1};      // -1 if not listed
+    int wildcardQuality = -1;
+
+    while(!acceptEncoding.empty()){
+        std::size_t comma = acceptEncoding.find(',');
+        std::string_view element = acceptEncoding.substr(0, comma);
+        acceptEncoding = comma == std::string_view::npos ? std::string_view() : acceptEncoding.substr(comma + 1);
+
+        std::size_t semicolon = element.find(';');
+        std::string_view coding = trim(element.substr(0, semicolon));
+        int quality = 1000;
+        while(semicolon != std::string_view::npos){
+            element = element.substr(semicolon + 1);
+            semicolon = element.find(';');
+            std::string_view parameter = trim(element.substr(0, semicolon));
+            if(parameter.size() >= 2 && (parameter[0] == 'q' || parameter[0] == 'Q') && parameter[1] == '='){
+                quality = parseQuality(trim(parameter.substr(2)));
+            }
+        }
+
+        if(coding == "*") wildcardQuality = quality;
+        else if(HttpHeader::equals(coding, "br")) qualities[ENCODING_BROTLI] = quality;
+        else if(HttpHeader::equals(coding, "gzip") || HttpHeader::equals(coding, "x-gzip")) qualities[ENCODING_GZIP] = quality;
+        else if(HttpHeader::equals(coding, "deflate")) qualities[ENCODING_DEFLATE] = quality;
+    }
+
+    ContentEncoding best = ENCODING_IDENTITY;
+    int bestQuality = 0;
+    for(ContentEncoding encoding : {ENCODING_BROTLI, ENCODING_GZIP, ENCODING_DEFLATE}){
+        if(!availableEncodings[encoding]) continue;
+        int quality = qualities[encoding] >= 0 ? qualities[encoding] : wildcardQuality;
+        if(quality > bestQuality){
+            best = encoding;
+            bestQuality = quality;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Gets the `Content-Encoding` token of an encoding.
+ *
+ * @param encoding The encoding.
+ * @return The token (e.g., "br").
+ */
+const char* contentEncodingName(ContentEncoding encoding){
+    static const char* const encodingNames[ENCODING_COUNT] = {"identity", "gzip", "deflate", "br"};
+    return encodingNames[encoding];
+}
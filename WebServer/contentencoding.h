@@ -0,0 +1,21 @@
+#ifndef CONTENTENCODING_H
+#define CONTENTENCODING_H
+#include <string_view>
+
+/**
+ * @brief The content codings a response body can be sent in.
+ *
+ * The values index arrays of per-encoding flags, e.g. the encodings a response is available in.
+ */
+enum ContentEncoding {
+    ENCODING_IDENTITY,
+    ENCODING_GZIP,
+    ENCODING_DEFLATE,
+    ENCODING_BROTLI,
+    ENCODING_COUNT
+};
+
+ContentEncoding negotiateContentEncoding(std::string_view acceptEncoding, const bool (&availableEncodings)[ENCODING_COUNT]);
+const char* contentEncodingName(ContentEncoding encoding);
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef CONTEXTKEY_H
+#define CONTEXTKEY_H
+#include <cstddef>
+#include "requestcontext.h"
+
+/**
+ * @brief Identifies a typed slot of the per-request context.
+ *
+ * Create keys once at startup, e.g. as global variables, and use them to attach values to a request
+ * in middleware and read them in the handler:
+ * @code
+ * ContextKey<User> currentUser;
+ *
+ * MiddlewareResult authenticate(Request& req){
+ *     req.setContext(currentUser, decodeUser(req.getRequestHeader("authorization")));
+ *     return Middleware::next();
+ * }
+ *
+ * Response profile(Request& req){
+ *     User* user = req.getContext(currentUser);
+ *     ...
+ * }
+ * @endcode
+ *
+ * @tparam T The type of the value stored in the slot.
+ */
+template <typename T>
+class ContextKey{
+private:
+    std::size_t slot;
+
+public:
+    /**
+     * @brief Reserves a new slot.
+     *
+     * @throw std::runtime_error if more than RequestContext::capacity keys are created.
+     */
+    ContextKey(): slot(RequestContext::allocateSlot()) {}
+
+    ContextKey(const ContextKey&) = delete;
+    ContextKey& operator=(const ContextKey&) = delete;
+
+    std::size_t getSlot() const { return slot; }
+};
+
+#endif
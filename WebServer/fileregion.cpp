@@ -0,0 +1,62 @@
+#include "fileregion.h"
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <cstdio>
+
+/**
+ * @brief Opens a file for reading, the region covers the whole file.
+ *
+ * @param filePath The path of the file.
+ * @return The region, which is not open if the file cannot be opened or is not a regular file.
+ */
+FileRegion FileRegion::open(const std::string &filePath){
+    FileRegion region;
+    int fileDescriptor = _open(filePath.c_str(), _O_RDONLY | _O_BINARY);
+    if(fileDescriptor < 0) return region;
+
+    struct _stat64 fileStatus;
+    if(_fstat64(fileDescriptor, &fileStatus) != 0 || !(fileStatus.st_mode & S_IFREG)){
+        _close(fileDescriptor);
+        return region;
+    }
+    region.descriptor = std::shared_ptr<const int>(new int(fileDescriptor), [](const int* openDescriptor){
+        _close(*openDescriptor);
+        delete openDescriptor;
+    });
+    region.length = static_cast<std::uint64_t>(fileStatus.st_size);
+    return region;
+}
+
+/**
+ * @brief Gets a part of the region, which shares the open file.
+ *
+ * @param offset The offset of the part, relative to the start of this region.
+ * @param length The number of bytes, clamped to the end of this region.
+ * @return The part, empty if the offset is past the end of this region.
+ */
+FileRegion FileRegion::slice(std::uint64_t offset, std::uint64_t length) const{
+    FileRegion part = *this;
+    if(offset > this->length) offset = this->length;
+    part.offset = this->offset + offset;
+    part.length = length < this->length - offset ? length : this->length - offset;
+    return part;
+}
+
+/**
+ * @brief Reads bytes of the region into memory, for bodies that have to be transformed before they are sent.
+ *
+ * @param position The position to read from, relative to the start of the region.
+ * @param buffer The buffer to read into.
+ * @param capacity The size of the buffer.
+ * @return The number of bytes read, 0 at the end of the region or if the file cannot be read.
+ */
+std::size_t FileRegion::read(std::uint64_t position, char *buffer, std::size_t capacity) const{
+    if(!descriptor || position >= length) return 0;
+    std::uint64_t remaining = length - position;
+    unsigned int bytesToRead = static_cast<unsigned int>(capacity < remaining ? capacity : remaining);
+    if(bytesToRead > (1u << 30)) bytesToRead = 1u << 30;
+    if(_lseeki64(*descriptor, static_cast<long long>(offset + position), SEEK_SET) < 0) return 0;
+    int bytesRead = _read(*descriptor, buffer, bytesToRead);
+    return bytesRead > 0 ? static_cast<std::size_t>(bytesRead) : 0;
+}
@@ -0,0 +1,38 @@
+#ifndef FILEREGION_H
+#define FILEREGION_H
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @brief A byte range of an open file, which the server sends without reading it into memory.
+ *
+ * The file descriptor is shared by all copies of a region and closed when the last one is
+ * destroyed, so a region can be copied along with its Response and sliced into smaller regions:
+ * @code
+ * FileRegion video = FileRegion::open("./public/intro.mp4");
+ * if(video.isOpen()) res.setFileContent(video.slice(0, 1024 * 1024));
+ * @endcode
+ */
+class FileRegion{
+private:
+    std::shared_ptr<const int> descriptor;  ///< The CRT file descriptor, empty if no file is open
+    std::uint64_t offset = 0;               ///< The first byte of the region
+    std::uint64_t length = 0;               ///< The number of bytes in the region
+
+public:
+    FileRegion() = default;
+
+    static FileRegion open(const std::string& filePath);
+
+    bool isOpen() const { return descriptor != nullptr; }
+    int getDescriptor() const { return descriptor ? *descriptor : -1; }
+    std::uint64_t getOffset() const { return offset; }
+    std::uint64_t getLength() const { return length; }
+
+    FileRegion slice(std::uint64_t offset, std::uint64_t length) const;
+    std::size_t read(std::uint64_t position, char* buffer, std::size_t capacity) const;
+};
+
+#endif
@@ -0,0 +1,153 @@
+#include "httpdate.h"
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Writes a number with a fixed count of digits, padded with zeros.
+ *
+ * @param output The buffer to write to.
+ * @param value The number.
+ * @param digits The number of digits.
+ * @return The position after the digits.
+ */
+static char* writeDigits(char* output, std::int64_t value, int digits){
+    for(int i = digits - 1; i >= 0; i--){
+        output[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    return output + digits;
+}
+
+static const char weekdayNames[] = "ThuFriSatSunMonTueWed";     // 1970-01-01 was a Thursday
+static const char monthNames[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+/**
+ * @brief Reads a number with a fixed count of digits.
+ *
+ * @param text The text.
+ * @param position The position of the first digit.
+ * @param digits The number of digits.
+ * @param value Set to the number.
+ * @return False if one of the characters is not a digit.
+ */
+static bool readDigits(std::string_view text, std::size_t position, int digits, int &value){
+    value = 0;
+    for(int i = 0; i < digits; i++){
+        char c = text[position + i];
+        if(c < '0' || c > '9') return false;
+        value = value * 10 + (c - '0');
+    }
+    return true;
+}
+
+/**
+ * @brief Formats a time as an HTTP date, e.g. "Sun, 06 Nov 1994 08:49:37 GMT".
+ *
+ * The calendar date is computed from the days since the epoch directly (the days-to-civil
+ * algorithm of the proleptic Gregorian calendar), which avoids `gmtime` and its shared state.
+ *
+ * @param seconds Seconds since the Unix epoch, in UTC.
+ * @param output The buffer, at least formattedLength bytes. It is not null-terminated.
+ */
+void HttpDate::format(std::time_t seconds, char *output){
+    std::int64_t time = static_cast<std::int64_t>(seconds);
+    std::int64_t days = time / 86400;
+    std::int64_t secondOfDay = time % 86400;
+    if(secondOfDay < 0){
+        secondOfDay += 86400;
+        days--;
+    }
+    std::int64_t weekday = days % 7;
+    if(weekday < 0) weekday += 7;
+
+    // Days to year, month and day, with years starting in March so the leap day is the last day of a year
+    std::int64_t shiftedDays = days + 719468;
+    std::int64_t era = (shiftedDays >= 0 ? shiftedDays : shiftedDays - 146096) / 146097;
+    std::int64_t dayOfEra = shiftedDays - era * 146097;
+    std::int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    std::int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    std::int64_t shiftedMonth = (5 * dayOfYear + 2) / 153;
+    std::int64_t day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    std::int64_t month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+    std::int64_t year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+
+    std::memcpy(output, weekdayNames + weekday * 3, 3);
+    output[3] = ',';
+    output[4] = ' ';
+    char* position = writeDigits(output + 5, day, 2);
+    *position++ = ' ';
+    std::memcpy(position, monthNames + (month - 1) * 3, 3);
+    position += 3;
+    *position++ = ' ';
+    position = writeDigits(position, year, 4);
+    *position++ = ' ';
+    position = writeDigits(position, secondOfDay / 3600, 2);
+    *position++ = ':';
+    position = writeDigits(position, secondOfDay / 60 % 60, 2);
+    *position++ = ':';
+    position = writeDigits(position, secondOfDay % 60, 2);
+    std::memcpy(position, " GMT", 4);
+}
+
+/**
+ * @brief Parses an HTTP date in the IMF-fixdate format, e.g. "Sun, 06 Nov 1994 08:49:37 GMT".
+ *
+ * The obsolete RFC 850 and asctime formats are not accepted. The day name is not checked.
+ *
+ * @param text The date, e.g. the value of an `If-Modified-Since` header.
+ * @param seconds Set to the seconds since the Unix epoch.
+ * @return False if the text is not a valid date.
+ */
+bool HttpDate::parse(std::string_view text, std::time_t &seconds){
+    if(text.size() != formattedLength || text.substr(3, 2) != ", " || text[7] != ' ' || text[11] != ' ' ||
+       text[16] != ' ' || text[19] != ':' || text[22] != ':' || text.substr(25) != " GMT"){
+        return false;
+    }
+    int day, year, hour, minute, second;
+    if(!readDigits(text, 5, 2, day) || !readDigits(text, 12, 4, year) || !readDigits(text, 17, 2, hour) ||
+       !readDigits(text, 20, 2, minute) || !readDigits(text, 23, 2, second)){
+        return false;
+    }
+    std::string_view months(monthNames, 36);
+    std::size_t monthIndex = months.find(text.substr(8, 3));
+    if(monthIndex == std::string_view::npos || monthIndex % 3 != 0) return false;
+    if(day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) return false;
+
+    // Year, month and day to days since the epoch, the inverse of the conversion in format
+    std::int64_t month = static_cast<std::int64_t>(monthIndex / 3) + 1;
+    std::int64_t shiftedYear = year - (month <= 2 ? 1 : 0);
+    std::int64_t era = (shiftedYear >= 0 ? shiftedYear : shiftedYear - 399) / 400;
+    std::int64_t yearOfEra = shiftedYear - era * 400;
+    std::int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    std::int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    std::int64_t days = era * 146097 + dayOfEra - 719468;
+
+    seconds = static_cast<std::time_t>(days * 86400 + hour * 3600 + minute * 60 + second);
+    return true;
+}
+
+/**
+ * @brief Gets the `Date` header line for the current time.
+ *
+ * @return The line including its CRLF. It stays valid until the next call.
+ */
+std::string_view HttpDate::getHeaderLine(){
+    return getHeaderLine(std::time(nullptr));
+}
+
+/**
+ * @brief Gets the `Date` header line for a time, formatting it only if the second changed since the last call.
+ *
+ * @param now Seconds since the Unix epoch.
+ * @return The line including its CRLF. It stays valid until the next call.
+ */
+std::string_view HttpDate::getHeaderLine(std::time_t now){
+    if(now != formattedSecond){
+        std::memcpy(headerLine, "Date: ", 6);
+        format(now, headerLine + 6);
+        headerLine[6 + formattedLength] = '\r';
+        headerLine[6 + formattedLength + 1] = '\n';
+        formattedSecond = now;
+    }
+    return std::string_view(headerLine, sizeof(headerLine));
+}
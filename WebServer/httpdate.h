@@ -0,0 +1,35 @@
+#ifndef HTTPDATE_H
+#define HTTPDATE_H
+#include <cstddef>
+#include <ctime>
+#include <string_view>
+
+/**
+ * @brief A pre-formatted `Date` header line, reformatted only when the second changes.
+ *
+ * Every response carries a `Date` header. Formatting it with `gmtime` and `strftime` on every
+ * request is wasted work, since it only changes once per second, so each server keeps one of these
+ * and responses copy the 37 bytes of the cached line:
+ * @code
+ * Date: Sun, 06 Nov 1994 08:49:37 GMT\r\n
+ * @endcode
+ * The date is formatted in the IMF-fixdate format of RFC 9110 without the C locale functions, so
+ * the result does not depend on the locale or timezone.
+ */
+class HttpDate{
+public:
+    static const std::size_t formattedLength = 29;     ///< The length of a formatted date, e.g. "Sun, 06 Nov 1994 08:49:37 GMT"
+
+private:
+    std::time_t formattedSecond = -1;                   ///< The second headerLine was formatted for
+    char headerLine[6 + formattedLength + 2] = {};      ///< "Date: " + date + CRLF
+
+public:
+    std::string_view getHeaderLine();
+    std::string_view getHeaderLine(std::time_t now);
+
+    static void format(std::time_t seconds, char* output);
+    static bool parse(std::string_view text, std::time_t& seconds);
+};
+
+#endif
@@ -0,0 +1,39 @@
+#include <cctype>
+
+#include "httpheader.h"
+
+static constexpr std::string_view wellKnownHeaders[] = {
+    HttpHeader::ACCEPT_RANGES, HttpHeader::ACCESS_CONTROL_ALLOW_ORIGIN, HttpHeader::AGE, HttpHeader::ALLOW,
+    HttpHeader::CACHE_CONTROL, HttpHeader::CONNECTION, HttpHeader::CONTENT_DISPOSITION, HttpHeader::CONTENT_ENCODING,
+    HttpHeader::CONTENT_LANGUAGE, HttpHeader::CONTENT_LENGTH, HttpHeader::CONTENT_RANGE, HttpHeader::CONTENT_TYPE,
+    HttpHeader::DATE, HttpHeader::ETAG, HttpHeader::EXPIRES, HttpHeader::LAST_MODIFIED, HttpHeader::LOCATION,
+    HttpHeader::RETRY_AFTER, HttpHeader::SERVER, HttpHeader::SET_COOKIE, HttpHeader::TRANSFER_ENCODING,
+    HttpHeader::VARY, HttpHeader::WWW_AUTHENTICATE
+};
+
+/**
+ * @brief Compares two header names, ignoring case.
+ *
+ * @return True if the names are equal.
+ */
+bool HttpHeader::equals(std::string_view name, std::string_view otherName){
+    if(name.size() != otherName.size()) return false;
+    for(std::size_t i = 0; i < name.size(); i++){
+        if(std::tolower(static_cast<unsigned char>(name[i])) != std::tolower(static_cast<unsigned char>(otherName[i]))) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Gets the interned constant of a well-known header name.
+ *
+ * @param name The header name in any case, e.g. "cache-control".
+ * @return The constant with its canonical spelling, e.g. HttpHeader::CACHE_CONTROL, or an empty view
+ *         if the header is not well-known.
+ */
+std::string_view HttpHeader::intern(std::string_view name){
+    for(std::string_view wellKnownHeader : wellKnownHeaders){
+        if(equals(name, wellKnownHeader)) return wellKnownHeader;
+    }
+    return std::string_view();
+}
@@ -0,0 +1,43 @@
+#ifndef HTTPHEADER_H
+#define HTTPHEADER_H
+#include <string_view>
+
+/**
+ * @brief Interned names of well-known HTTP headers.
+ *
+ * Response headers with these names store a view of the constant instead of a copy of the name:
+ * @code
+ * res.setHeader(HttpHeader::CACHE_CONTROL, "max-age=3600");
+ * @endcode
+ * Names passed as strings are interned too if they match one of the constants, ignoring case.
+ */
+struct HttpHeader {
+    static constexpr std::string_view ACCEPT_RANGES = "Accept-Ranges";
+    static constexpr std::string_view ACCESS_CONTROL_ALLOW_ORIGIN = "Access-Control-Allow-Origin";
+    static constexpr std::string_view AGE = "Age";
+    static constexpr std::string_view ALLOW = "Allow";
+    static constexpr std::string_view CACHE_CONTROL = "Cache-Control";
+    static constexpr std::string_view CONNECTION = "Connection";
+    static constexpr std::string_view CONTENT_DISPOSITION = "Content-Disposition";
+    static constexpr std::string_view CONTENT_ENCODING = "Content-Encoding";
+    static constexpr std::string_view CONTENT_LANGUAGE = "Content-Language";
+    static constexpr std::string_view CONTENT_LENGTH = "Content-Length";
+    static constexpr std::string_view CONTENT_RANGE = "Content-Range";
+    static constexpr std::string_view CONTENT_TYPE = "Content-Type";
+    static constexpr std::string_view DATE = "Date";
+    static constexpr std::string_view ETAG = "ETag";
+    static constexpr std::string_view EXPIRES = "Expires";
+    static constexpr std::string_view LAST_MODIFIED = "Last-Modified";
+    static constexpr std::string_view LOCATION = "Location";
+    static constexpr std::string_view RETRY_AFTER = "Retry-After";
+    static constexpr std::string_view SERVER = "Server";
+    static constexpr std::string_view SET_COOKIE = "Set-Cookie";
+    static constexpr std::string_view TRANSFER_ENCODING = "Transfer-Encoding";
+    static constexpr std::string_view VARY = "Vary";
+    static constexpr std::string_view WWW_AUTHENTICATE = "WWW-Authenticate";
+
+    static std::string_view intern(std::string_view name);
+    static bool equals(std::string_view name, std::string_view otherName);
+};
+
+#endif
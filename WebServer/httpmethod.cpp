@@ -0,0 +1,25 @@
+#include "httpmethod.h"
+
+/**
+ * @brief Converts a request method string to an HttpMethod.
+ *
+ * @param method The method as sent in the request line (e.g., "GET").
+ * @return The matching HttpMethod, or HTTP_METHOD_COUNT if the method is not supported.
+ */
+HttpMethod parseHttpMethod(const std::string &method){
+    for(int i = 0; i < HTTP_METHOD_COUNT; i++){
+        if(method == httpMethodName(static_cast<HttpMethod>(i))) return static_cast<HttpMethod>(i);
+    }
+    return HTTP_METHOD_COUNT;
+}
+
+/**
+ * @brief Gets the name of an HttpMethod as used in request lines and the Allow header.
+ *
+ * @param method The method.
+ * @return The method name (e.g., "GET").
+ */
+const char* httpMethodName(HttpMethod method){
+    static const char* const methodNames[HTTP_METHOD_COUNT] = {"GET", "POST", "PUT", "PATCH", "DELETE"};
+    return methodNames[method];
+}
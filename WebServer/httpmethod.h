@@ -0,0 +1,24 @@
+#ifndef HTTPMETHOD_H
+#define HTTPMETHOD_H
+#include <string>
+
+/**
+ * @brief The HTTP methods that routes can be registered for.
+ *
+ * The values index the per-method arrays stored on every route. `HTTP_METHOD_COUNT` is the
+ * number of supported methods and is also returned for methods the server does not support.
+ * The names carry a prefix because `DELETE` is a macro in the Windows headers.
+ */
+enum HttpMethod {
+    HTTP_GET,
+    HTTP_POST,
+    HTTP_PUT,
+    HTTP_PATCH,
+    HTTP_DELETE,
+    HTTP_METHOD_COUNT
+};
+
+HttpMethod parseHttpMethod(const std::string& method);
+const char* httpMethodName(HttpMethod method);
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef HTTPSTATUS_H
+#define HTTPSTATUS_H
+#include <string_view>
+
+std::string_view httpStatusLine(int statusCode);
+std::string_view httpStatusMessage(int statusCode);
+
+#endif
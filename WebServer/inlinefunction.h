@@ -0,0 +1,118 @@
+#ifndef INLINEFUNCTION_H
+#define INLINEFUNCTION_H
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename Signature, std::size_t Capacity = 48>
+class InlineFunction;
+
+/**
+ * @brief A function wrapper that stores its callable inline.
+ *
+ * Holds any callable with the given signature: function pointers, lambdas with captures or
+ * functors. Unlike `std::function`, the callable always lives in a fixed buffer inside the
+ * wrapper, so constructing, moving and calling it never allocate. A callable that does not fit
+ * into `Capacity` bytes is a compile error; capture a pointer or reference to large state instead.
+ * The wrapper is move-only, so move-only callables, e.g. lambdas that capture a `std::unique_ptr`,
+ * can be stored as well. Calling it is not a const operation, since the stored callable may
+ * change its own state.
+ *
+ * Calling the wrapper is a single indirect call through a function pointer generated for the
+ * stored callable's type.
+ *
+ * @tparam R The return type.
+ * @tparam Args The parameter types.
+ * @tparam Capacity The size of the inline buffer in bytes.
+ */
+template <typename R, typename... Args, std::size_t Capacity>
+class InlineFunction<R(Args...), Capacity>{
+private:
+    enum Operation { MOVE, DESTROY };
+
+    alignas(std::max_align_t) unsigned char storage[Capacity];
+    R (*invoker)(void* callable, Args... args) = nullptr;
+    void (*manager)(Operation operation, void* callable, void* destination) = nullptr;    ///< Moves or destroys the stored callable
+
+    template <typename F>
+    static R invoke(void* callable, Args... args){
+        return (*static_cast<F*>(callable))(std::forward<Args>(args)...);
+    }
+
+    template <typename F>
+    static void manage(Operation operation, void* callable, void* destination){
+        if(operation == MOVE){
+            new (destination) F(std::move(*static_cast<F*>(callable)));
+        }
+        static_cast<F*>(callable)->~F();
+    }
+
+    void reset(){
+        if(manager) manager(DESTROY, storage, nullptr);
+        invoker = nullptr;
+        manager = nullptr;
+    }
+
+public:
+    InlineFunction() noexcept {}
+    InlineFunction(std::nullptr_t) noexcept {}
+
+    /**
+     * @brief Stores a callable.
+     *
+     * @param callable The callable. A null function pointer leaves the wrapper empty.
+     */
+    template <typename F,
+              typename Callable = std::decay_t<F>,
+              typename = std::enable_if_t<!std::is_same<Callable, InlineFunction>::value && std::is_invocable_r<R, Callable&, Args...>::value>>
+    InlineFunction(F&& callable){
+        static_assert(sizeof(Callable) <= Capacity, "Callable is too large for InlineFunction, capture a pointer or reference to its state instead");
+        static_assert(alignof(Callable) <= alignof(std::max_align_t), "Callable is over-aligned for InlineFunction");
+        static_assert(std::is_nothrow_move_constructible<Callable>::value, "InlineFunction requires a callable that can be moved without throwing");
+        if constexpr(std::is_pointer<std::remove_reference_t<F>>::value || std::is_member_pointer<std::remove_reference_t<F>>::value){
+            if(callable == nullptr) return;
+        }
+        new (storage) Callable(std::forward<F>(callable));
+        invoker = &invoke<Callable>;
+        manager = &manage<Callable>;
+    }
+
+    InlineFunction(InlineFunction&& other) noexcept : invoker(other.invoker), manager(other.manager) {
+        if(manager) manager(MOVE, other.storage, storage);
+        other.invoker = nullptr;
+        other.manager = nullptr;
+    }
+
+    InlineFunction& operator=(InlineFunction&& other) noexcept {
+        if(this != &other){
+            reset();
+            invoker = other.invoker;
+            manager = other.manager;
+            if(manager) manager(MOVE, other.storage, storage);
+            other.invoker = nullptr;
+            other.manager = nullptr;
+        }
+        return *this;
+    }
+
+    InlineFunction(const InlineFunction&) = delete;
+    InlineFunction& operator=(const InlineFunction&) = delete;
+
+    ~InlineFunction(){
+        reset();
+    }
+
+    /**
+     * @brief Calls the stored callable. The wrapper must not be empty.
+     *
+     * Not const: the callable may change its own state, e.g. a `mutable` lambda.
+     */
+    R operator()(Args... args){
+        return invoker(storage, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept { return invoker != nullptr; }
+};
+
+#endif
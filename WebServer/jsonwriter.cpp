@@ -0,0 +1,280 @@
+#include "jsonwriter.h"
+#include "response.h"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+#if !defined(WEBSERVER_JSON_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define WEBSERVER_JSON_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+/**
+ * @brief Starts a JSON body for a response.
+ *
+ * Sets the content type to `application/json` and replaces the content with an empty string that
+ * the writer appends to. The response must outlive the writer.
+ *
+ * @param response The response.
+ */
+JsonWriter::JsonWriter(Response &response): output(response.httpBody.getString()) {
+    output.clear();
+    response.httpContentType = "application/json";
+}
+
+/**
+ * @brief Starts a writer that appends to a string, e.g. to cache a document or embed it in a page.
+ *
+ * @param output The string, which must outlive the writer.
+ */
+JsonWriter::JsonWriter(std::string &output): output(output) {}
+
+/**
+ * @brief Writes the ',' before a value, unless it is the first of its object or array or follows a key.
+ */
+void JsonWriter::beforeValue(){
+    if(afterKey){
+        afterKey = false;
+        return;
+    }
+    if(needsComma) output.push_back(',');
+    needsComma = true;
+}
+
+/**
+ * @brief Starts an object, as a value or as the whole document.
+ */
+JsonWriter& JsonWriter::beginObject(){
+    beforeValue();
+    output.push_back('{');
+    needsComma = false;
+    return *this;
+}
+
+/**
+ * @brief Ends the current object.
+ */
+JsonWriter& JsonWriter::endObject(){
+    output.push_back('}');
+    needsComma = true;      // The object was a value of its parent
+    return *this;
+}
+
+/**
+ * @brief Starts an array, as a value or as the whole document.
+ */
+JsonWriter& JsonWriter::beginArray(){
+    beforeValue();
+    output.push_back('[');
+    needsComma = false;
+    return *this;
+}
+
+/**
+ * @brief Ends the current array.
+ */
+JsonWriter& JsonWriter::endArray(){
+    output.push_back(']');
+    needsComma = true;
+    return *this;
+}
+
+/**
+ * @brief Writes the key of the next member of the current object.
+ *
+ * @param name The key, escaped like any string.
+ */
+JsonWriter& JsonWriter::key(std::string_view name){
+    if(needsComma) output.push_back(',');
+    appendString(output, name);
+    output.push_back(':');
+    needsComma = true;
+    afterKey = true;
+    return *this;
+}
+
+/**
+ * @brief Writes a string.
+ *
+ * @param text The string in UTF-8, which is escaped.
+ */
+JsonWriter& JsonWriter::value(std::string_view text){
+    beforeValue();
+    appendString(output, text);
+    return *this;
+}
+
+/**
+ * @brief Writes a string, null for a null pointer.
+ *
+ * @param text The null-terminated string in UTF-8, which is escaped.
+ */
+JsonWriter& JsonWriter::value(const char *text){
+    if(!text) return value(nullptr);
+    return value(std::string_view(text));
+}
+
+/**
+ * @brief Writes true or false.
+ */
+JsonWriter& JsonWriter::value(bool boolean){
+    beforeValue();
+    if(boolean) output.append("true", 4);
+    else output.append("false", 5);
+    return *this;
+}
+
+/**
+ * @brief Writes null.
+ */
+JsonWriter& JsonWriter::value(std::nullptr_t){
+    beforeValue();
+    output.append("null", 4);
+    return *this;
+}
+
+/**
+ * @brief Writes a floating-point number in the shortest form that reads back as the same number.
+ *
+ * @param number The number. NaN and infinity are written as null.
+ */
+JsonWriter& JsonWriter::value(double number){
+    if(!std::isfinite(number)) return value(nullptr);
+    beforeValue();
+    char digits[32];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number);
+    output.append(digits, result.ptr - digits);
+    return *this;
+}
+
+/**
+ * @brief Writes JSON that is already serialized, e.g. a cached fragment, as a value.
+ *
+ * @param json The serialized value, which is written as it is.
+ */
+JsonWriter& JsonWriter::rawValue(std::string_view json){
+    beforeValue();
+    output.append(json.data(), json.size());
+    return *this;
+}
+
+void JsonWriter::writeSigned(std::int64_t number){
+    beforeValue();
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number);
+    output.append(digits, result.ptr - digits);
+}
+
+void JsonWriter::writeUnsigned(std::uint64_t number){
+    beforeValue();
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number);
+    output.append(digits, result.ptr - digits);
+}
+
+/**
+ * @brief Reserves room for the rest of the document, so that the body string does not grow while it is written.
+ *
+ * @param size The expected number of bytes still to be written.
+ */
+void JsonWriter::reserve(std::size_t size){
+    output.reserve(output.size() + size);
+}
+
+/**
+ * @brief Appends the escape sequence of a character that cannot appear in a JSON string as it is.
+ *
+ * @param output The string to append to.
+ * @param c A quote, a backslash or a control character.
+ */
+static void appendEscaped(std::string &output, unsigned char c){
+    static const char hexDigits[] = "0123456789abcdef";
+    switch(c){
+        case '"': output.append("\\\"", 2); break;
+        case '\\': output.append("\\\\", 2); break;
+        case '\b': output.append("\\b", 2); break;
+        case '\f': output.append("\\f", 2); break;
+        case '\n': output.append("\\n", 2); break;
+        case '\r': output.append("\\r", 2); break;
+        case '\t': output.append("\\t", 2); break;
+        default: {
+            char escape[6] = {'\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 0xf]};
+            output.append(escape, sizeof(escape));
+        }
+    }
+}
+
+/**
+ * @brief Checks whether a character must be escaped in a JSON string.
+ */
+static bool needsEscape(unsigned char c){
+    return c < 0x20 || c == '"' || c == '\\';
+}
+
+#ifdef WEBSERVER_JSON_SSE2
+/**
+ * @brief Gets the index of the lowest set bit of a non-zero mask.
+ */
+static unsigned int lowestSetBit(unsigned int mask){
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned int>(index);
+#else
+    return static_cast<unsigned int>(__builtin_ctz(mask));
+#endif
+}
+#endif
+
+/**
+ * @brief Appends a string as a quoted and escaped JSON string.
+ *
+ * Runs of characters that need no escaping are copied at once. With SSE2, 16 bytes are checked
+ * for quotes, backslashes and control characters with three comparisons and one mask, so typical
+ * text that needs no escaping costs little more than a copy. Bytes of multi-byte UTF-8 sequences
+ * are copied as they are.
+ *
+ * @param output The string to append to.
+ * @param text The string in UTF-8.
+ */
+void JsonWriter::appendString(std::string &output, std::string_view text){
+    output.push_back('"');
+    const char* data = text.data();
+    std::size_t size = text.size();
+    std::size_t position = 0;
+    std::size_t runStart = 0;       // The start of the characters not yet appended
+
+#ifdef WEBSERVER_JSON_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i lastControl = _mm_set1_epi8(0x1f);
+    while(position + 16 <= size){
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+        // A byte is a control character if its unsigned minimum with 0x1f is itself
+        __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, backslash)),
+                                       _mm_cmpeq_epi8(_mm_min_epu8(block, lastControl), block));
+        unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(special));
+        if(mask == 0){
+            position += 16;
+            continue;
+        }
+        std::size_t escapePosition = position + lowestSetBit(mask);
+        output.append(data + runStart, escapePosition - runStart);
+        appendEscaped(output, static_cast<unsigned char>(data[escapePosition]));
+        position = runStart = escapePosition + 1;
+    }
+#endif
+
+    for(; position < size; position++){
+        unsigned char c = static_cast<unsigned char>(data[position]);
+        if(!needsEscape(c)) continue;
+        output.append(data + runStart, position - runStart);
+        appendEscaped(output, c);
+        runStart = position + 1;
+    }
+    output.append(data + runStart, size - runStart);
+    output.push_back('"');
+}
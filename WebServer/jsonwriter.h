@@ -0,0 +1,92 @@
+#ifndef JSONWRITER_H
+#define JSONWRITER_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+class Response;
+
+/**
+ * @brief Writes JSON directly into the body of a response, without building it elsewhere first.
+ *
+ * Building a JSON body by concatenating strings or with `nlohmann::json::dump()` produces a
+ * temporary string that is then copied into the response. The writer appends to the response's
+ * own body string instead, which the server sends as it is:
+ * @code
+ * Response res;
+ * JsonWriter json(res);
+ * json.beginObject();
+ * json.key("name").value(user.name);
+ * json.key("age").value(user.age);
+ * json.key("tags").beginArray();
+ * for(const std::string& tag : user.tags) json.value(tag);
+ * json.endArray();
+ * json.endObject();
+ * return res;
+ * @endcode
+ * Commas and colons are inserted automatically. Strings are escaped 16 bytes at a time with SSE2
+ * where the target supports it (on x86-64 always), with a scalar loop elsewhere or when compiled
+ * with `-DWEBSERVER_JSON_NO_SIMD`. Numbers are formatted with `std::to_chars`, floating-point
+ * numbers in their shortest form that reads back exactly; NaN and infinity, which JSON cannot
+ * represent, are written as null. The only allocations are those of the body string as it grows,
+ * which reserve() avoids for a known size.
+ *
+ * The writer does not check that the calls form a valid document, e.g. that every beginObject has
+ * its endObject.
+ */
+class JsonWriter{
+private:
+    std::string& output;
+    bool needsComma = false;        ///< Whether the next value or key in the current object or array needs a ',' before it
+    bool afterKey = false;          ///< Whether a key was just written, so the next value needs no ','
+
+    void beforeValue();
+    void writeSigned(std::int64_t number);
+    void writeUnsigned(std::uint64_t number);
+
+public:
+    explicit JsonWriter(Response& response);
+    explicit JsonWriter(std::string& output);
+
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+    JsonWriter& key(std::string_view name);
+
+    JsonWriter& value(std::string_view text);
+    JsonWriter& value(const char* text);
+    JsonWriter& value(bool boolean);
+    JsonWriter& value(std::nullptr_t);
+    JsonWriter& value(double number);
+    JsonWriter& rawValue(std::string_view json);
+
+    /**
+     * @brief Writes an integer.
+     *
+     * @param number The integer, of any integral type except bool.
+     */
+    template <typename Integer, typename = std::enable_if_t<std::is_integral<Integer>::value && !std::is_same<Integer, bool>::value>>
+    JsonWriter& value(Integer number){
+        if constexpr(std::is_signed<Integer>::value) writeSigned(static_cast<std::int64_t>(number));
+        else writeUnsigned(static_cast<std::uint64_t>(number));
+        return *this;
+    }
+
+    /**
+     * @brief Writes a key and its value, e.g. `json.member("id", 42)`.
+     */
+    template <typename T>
+    JsonWriter& member(std::string_view name, const T& memberValue){
+        key(name);
+        return value(memberValue);
+    }
+
+    void reserve(std::size_t size);
+
+    static void appendString(std::string& output, std::string_view text);
+};
+
+#endif
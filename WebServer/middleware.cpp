@@ -1,15 +1,9 @@
 #include "middleware.h"
 
-Response Middleware::nextObj;
-
-void Middleware::push(Response (*middlewareFunction)(Request &)){
-    listOfMiddlewareFunctions.push_back(middlewareFunction);
+void Middleware::push(MiddlewareFunction middlewareFunction){
+    listOfMiddlewareFunctions.push_back(std::make_shared<MiddlewareFunction>(std::move(middlewareFunction)));
 }
 
-Response Middleware::execute(Request &req){
-    for(auto it = listOfMiddlewareFunctions.begin(); it != listOfMiddlewareFunctions.end(); it++){
-        Response res = (*it)(req);
-        if(res != nextObj) return res;
-    }
-    return nextObj;
+void Middleware::pushAfter(AfterHook afterHook){
+    listOfAfterHooks.push_back(std::make_shared<AfterHook>(std::move(afterHook)));
 }
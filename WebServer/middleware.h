@@ -1,67 +1,113 @@
 #ifndef MIDDLEWARE_H
 #define MIDDLEWARE_H
-#include <list>
+#include <memory>
+#include <vector>
 #include "response.h"
 #include "request.h"
+#include "middlewareresult.h"
+#include "middlewarefunction.h"
+#include "afterhook.h"
 
 /**
  * @brief The Middleware class manages a list of middleware functions that process HTTP requests.
  *
  * This class is designed to allow chaining multiple middleware functions that each take a Request
- * object as a parameter and return a Response object. The middleware functions are stored in a list,
- * and the `execute` method processes a given Request object through these functions sequentially.
- * If a middleware function returns a Response object different from the predefined `next` object,
- * the execution stops and that Response object is returned. Otherwise, it proceeds to the next
- * middleware function.
+ * object as a parameter and return a MiddlewareResult. The middleware functions are stored in a list
+ * and run in order by the router, which composes them into the chain of each route. If a middleware
+ * function returns a Response, the execution stops and that Response answers the request. If it
+ * returns `Middleware::next()`, it proceeds to the next middleware function.
+ *
+ * After hooks run once the response function has returned and receive its Response by reference,
+ * so work such as timing, compression or adding headers can modify every response of a route.
  */
 class Middleware{
 private:
     /**
      * @brief A list of middleware functions.
      * 
-     * Each middleware function is a function pointer that takes a Request object as a parameter
-     * and returns a Response object.
-     */
-    std::list<Response (*) (Request &)> listOfMiddlewareFunctions;
-    
-    /**
-     * @brief A static Response object used to indicate continuation to the next middleware function.
+     * Each middleware function is a callable that takes a Request object as a parameter and returns
+     * a MiddlewareResult. Each callable is allocated once, when it is pushed, and never moves, so the
+     * chains composed by RadixTree::freeze point straight at it. Copies of a Middleware share the
+     * callables instead of copying them, so move-only callables can be pushed as well. A callable
+     * that changes its own state, e.g. a `mutable` lambda, keeps one state for every route and
+     * route snapshot it serves.
      */
-    static Response nextObj;
+    std::vector<std::shared_ptr<MiddlewareFunction>> listOfMiddlewareFunctions;
 
     /**
-     * @brief Executes the middleware functions sequentially with the given Request object.
-     * 
-     * Iterates through the list of middleware functions and processes the given Request object.
-     * If a middleware function returns a Response object different from `nextObj`, the execution
-     * stops and that Response object is returned. If all middleware functions return `nextObj`,
-     * the method returns `nextObj`.
-     * 
-     * @param req The Request object to be processed by the middleware functions.
-     * @return The Response object returned by a middleware function or `nextObj`.
+     * @brief A list of after hooks, run in order once the response function returned. Stored like the middleware functions.
      */
-    Response execute(Request &req);
+    std::vector<std::shared_ptr<AfterHook>> listOfAfterHooks;
 
 public:
     /**
-     * @brief Gets the static next Response object used to indicate continuation to the next middleware function.
+     * @brief Gets the result that continues with the next middleware function.
+     *
+     * The result holds no Response, so continuing costs nothing.
      * 
-     * @return The next Response object.
+     * @return An empty MiddlewareResult.
      */
-    static Response next() {return nextObj;};
+    static MiddlewareResult next() {return MiddlewareResult();};
 
     /**
      * @brief Adds a middleware function to the list.
      * 
-     * @param middlewareFunction A function pointer to a middleware function.
+     * @param middlewareFunction A middleware function, or a lambda or functor with the same signature.
+     *        Copies of the Middleware share it, including any state it captures.
      */
-    void push(Response (*middlewareFunction)(Request&));
+    void push(MiddlewareFunction middlewareFunction);
 
+    /**
+     * @brief Adds an after hook to the list.
+     *
+     * After hooks run in the order they were added, only for responses of the response function,
+     * not for responses returned by a middleware function.
+     *
+     * @param afterHook A function taking the Request and the Response to modify, or a lambda or functor with the same signature.
+     *        Copies of the Middleware share it, including any state it captures.
+     */
+    void pushAfter(AfterHook afterHook);
 
+    /**
+     * @brief Combines middleware functions known at compile time into a single function.
+     *
+     * The functions are called directly, in order, until one of them returns a Response, so the
+     * compiler can inline the whole chain into one function without indirect calls:
+     * @code
+     * server.use(&Middleware::chain<assignRequestId, logRequest, allowCors>);
+     * @endcode
+     *
+     * @tparam middlewareFunctions Functions taking a Request and returning a MiddlewareResult or Response.
+     * @param req The Request object to be processed by the middleware functions.
+     * @return The result of the function that responded, or `next()`.
+     */
+    template <auto... middlewareFunctions>
+    static MiddlewareResult chain(Request &req){
+        MiddlewareResult result;
+        ((result = middlewareFunctions(req)).isNext() && ...);
+        return result;
+    }
 
-    friend class AVLTree;
-    friend class WebServer;
+    /**
+     * @brief Combines middleware callables, such as lambdas with captures, into a single callable.
+     *
+     * Like `chain`, but for callables that are not functions. The callables are stored by value
+     * in the returned callable and called directly, in order, until one of them returns a Response.
+     *
+     * @param middlewareFunctions Callables taking a Request and returning a MiddlewareResult or Response.
+     * @return A callable that can be pushed or passed to WebServer::use.
+     */
+    template <typename... Functions>
+    static auto compose(Functions... middlewareFunctions){
+        return [middlewareFunctions...](Request &req) mutable {
+            MiddlewareResult result;
+            ((result = middlewareFunctions(req)).isNext() && ...);
+            return result;
+        };
+    }
 
+    friend class RadixTree;
+    friend class WebServer;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,24 @@
+#ifndef MIDDLEWAREFUNCTION_H
+#define MIDDLEWAREFUNCTION_H
+#include "inlinefunction.h"
+#include "middlewareresult.h"
+#include "request.h"
+
+/**
+ * @brief A middleware function.
+ *
+ * Returns `Middleware::next()` to continue or a Response to answer the request. Plain functions,
+ * lambdas with captures and functors are stored without heap allocation (see InlineFunction). A
+ * lambda that returns both needs an explicit return type:
+ * @code
+ * limits.push([&limiter](Request& req) -> MiddlewareResult {
+ *     if(limiter.allow(req)) return Middleware::next();
+ *     Response res;
+ *     res.setStatusCode(429);
+ *     return res;
+ * });
+ * @endcode
+ */
+using MiddlewareFunction = InlineFunction<MiddlewareResult(Request&)>;
+
+#endif
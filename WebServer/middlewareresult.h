@@ -0,0 +1,41 @@
+#ifndef MIDDLEWARERESULT_H
+#define MIDDLEWARERESULT_H
+#include <optional>
+#include <utility>
+#include "response.h"
+
+/**
+ * @brief The result of a middleware function: continue with the next function, or respond.
+ *
+ * `Middleware::next()` returns an empty result, which constructs no Response at all. Returning a
+ * Response converts it into a result that answers the request with that response, whatever its
+ * content, so a middleware function can also answer with an empty body:
+ * @code
+ * MiddlewareResult checkApiKey(Request& req){
+ *     std::unordered_map<std::string, std::string>::const_iterator key = req.getRequestQuery().find("key");
+ *     if(key != req.getRequestQuery().end() && key->second == "123") return Middleware::next();
+ *     Response res;
+ *     res.setStatusCode(401);
+ *     return res;
+ * }
+ * @endcode
+ */
+class MiddlewareResult{
+private:
+    std::optional<Response> response;   ///< Empty to continue with the next middleware function
+
+public:
+    MiddlewareResult() = default;
+    MiddlewareResult(Response response): response(std::move(response)) {}
+
+    /**
+     * @brief Checks whether the request continues with the next middleware function.
+     *
+     * @return True if no response was returned.
+     */
+    bool isNext() const { return !response.has_value(); }
+
+    friend class RadixTree;
+};
+
+#endif
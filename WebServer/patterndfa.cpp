@@ -0,0 +1,395 @@
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+
+#include "patterndfa.h"
+
+const std::size_t maxDfaStates = 10000;    ///< Guards against patterns whose DFA would blow up exponentially
+
+static void appendLiteral(std::string &regex, char c){
+    if(std::strchr(".+*?()|^$\\{}[]", c)) regex += '\\';
+    regex += c;
+}
+
+PatternDFA::PatternDFA(): classCount(0) {
+    std::memset(byteClass, 0, sizeof(byteClass));
+}
+
+/**
+ * @brief Adds a pattern.
+ *
+ * The pattern is parsed immediately so that syntax errors are reported at registration.
+ * It only takes part in matching after the next `compile()`.
+ *
+ * @param regex The regular expression. It is anchored at both ends, `^` and `$` are optional.
+ * @return The index of the pattern, which `match()` reports when the pattern matches.
+ * @throw std::runtime_error if the pattern is not a valid regular expression or uses syntax outside
+ *        the supported subset, such as `{n,m}` or `\b`.
+ */
+int PatternDFA::add(const std::string &regex){
+    nfa.clear();
+    std::size_t pos = 0;
+    parseAlternation(regex, pos);
+    if(pos != regex.size()){
+        throw std::runtime_error("Unbalanced ')' in route pattern " + regex);
+    }
+    nfa.clear();
+
+    patterns.push_back(regex);
+    return static_cast<int>(patterns.size()) - 1;
+}
+
+int PatternDFA::addState(){
+    nfa.emplace_back();
+    return static_cast<int>(nfa.size()) - 1;
+}
+
+PatternDFA::Fragment PatternDFA::charFragment(const std::bitset<256> &chars){
+    int start = addState();
+    int end = addState();
+    nfa[start].chars = chars;
+    nfa[start].next = end;
+    return Fragment{start, end};
+}
+
+PatternDFA::Fragment PatternDFA::parseAlternation(const std::string &pattern, std::size_t &pos){
+    Fragment fragment = parseConcatenation(pattern, pos);
+    while(pos < pattern.size() && pattern[pos] == '|'){
+        pos++;
+        Fragment alternative = parseConcatenation(pattern, pos);
+        int start = addState();
+        int end = addState();
+        nfa[start].epsilon.push_back(fragment.start);
+        nfa[start].epsilon.push_back(alternative.start);
+        nfa[fragment.end].epsilon.push_back(end);
+        nfa[alternative.end].epsilon.push_back(end);
+        fragment = Fragment{start, end};
+    }
+    return fragment;
+}
+
+PatternDFA::Fragment PatternDFA::parseConcatenation(const std::string &pattern, std::size_t &pos){
+    int empty = addState();
+    Fragment fragment{empty, empty};
+    while(pos < pattern.size() && pattern[pos] != '|' && pattern[pos] != ')'){
+        Fragment next = parseRepetition(pattern, pos);
+        nfa[fragment.end].epsilon.push_back(next.start);
+        fragment.end = next.end;
+    }
+    return fragment;
+}
+
+PatternDFA::Fragment PatternDFA::parseRepetition(const std::string &pattern, std::size_t &pos){
+    Fragment fragment = parseAtom(pattern, pos);
+    while(pos < pattern.size() && (pattern[pos] == '*' || pattern[pos] == '+' || pattern[pos] == '?')){
+        char quantifier = pattern[pos++];
+        int end = addState();
+        if(quantifier == '+'){
+            nfa[fragment.end].epsilon.push_back(fragment.start);
+            nfa[fragment.end].epsilon.push_back(end);
+            fragment = Fragment{fragment.start, end};
+            continue;
+        }
+        int start = addState();
+        nfa[start].epsilon.push_back(fragment.start);
+        nfa[start].epsilon.push_back(end);
+        if(quantifier == '*'){
+            nfa[fragment.end].epsilon.push_back(fragment.start);
+        }
+        nfa[fragment.end].epsilon.push_back(end);
+        fragment = Fragment{start, end};
+    }
+    return fragment;
+}
+
+PatternDFA::Fragment PatternDFA::parseAtom(const std::string &pattern, std::size_t &pos){
+    char c = pattern[pos];
+    std::bitset<256> chars;
+
+    if(c == '('){
+        pos++;
+        Fragment fragment = parseAlternation(pattern, pos);
+        if(pos >= pattern.size() || pattern[pos] != ')'){
+            throw std::runtime_error("Missing ')' in route pattern " + pattern);
+        }
+        pos++;
+        return fragment;
+    }
+    if(c == '*' || c == '+' || c == '?'){
+        throw std::runtime_error("Quantifier without an expression in route pattern " + pattern);
+    }
+    if((c == '^' && pos == 0) || (c == '$' && pos == pattern.size() - 1)){
+        // Patterns are always anchored
+        pos++;
+        int empty = addState();
+        return Fragment{empty, empty};
+    }
+    if(c == '{' || c == '}' || c == ']' || c == '^' || c == '$'){
+        // Counted repetition, stray brackets and inner anchors are not supported, rather than matched literally
+        throw std::runtime_error(std::string("Unsupported '") + c + "' in route pattern " + pattern);
+    }
+
+    if(c == '['){
+        chars = parseClass(pattern, pos);
+    }
+    else if(c == '\\'){
+        chars = parseEscape(pattern, pos);
+    }
+    else if(c == '.'){
+        chars.set();
+        pos++;
+    }
+    else{
+        chars.set(static_cast<unsigned char>(c));
+        pos++;
+    }
+    return charFragment(chars);
+}
+
+std::bitset<256> PatternDFA::parseClass(const std::string &pattern, std::size_t &pos){
+    std::bitset<256> chars;
+    pos++;  // '['
+    bool negated = pos < pattern.size() && pattern[pos] == '^';
+    if(negated) pos++;
+
+    bool first = true;
+    while(pos < pattern.size() && (pattern[pos] != ']' || first)){
+        first = false;
+        if(pattern[pos] == '\\'){
+            chars |= parseEscape(pattern, pos);
+            continue;
+        }
+        unsigned char low = static_cast<unsigned char>(pattern[pos++]);
+        unsigned char high = low;
+        if(pos + 1 < pattern.size() && pattern[pos] == '-' && pattern[pos + 1] != ']'){
+            high = static_cast<unsigned char>(pattern[pos + 1]);
+            pos += 2;
+        }
+        for(int b = low; b <= high; b++){
+            chars.set(b);
+        }
+    }
+    if(pos >= pattern.size()){
+        throw std::runtime_error("Missing ']' in route pattern " + pattern);
+    }
+    pos++;  // ']'
+
+    if(negated) chars.flip();
+    return chars;
+}
+
+std::bitset<256> PatternDFA::parseEscape(const std::string &pattern, std::size_t &pos){
+    pos++;  // '\'
+    if(pos >= pattern.size()){
+        throw std::runtime_error("Trailing '\\' in route pattern " + pattern);
+    }
+    char c = pattern[pos++];
+    std::bitset<256> chars;
+    switch(c){
+        case 'd': case 'D':
+            for(int b = '0'; b <= '9'; b++) chars.set(b);
+            break;
+        case 'w': case 'W':
+            for(int b = 0; b < 256; b++){
+                if(std::isalnum(b) || b == '_') chars.set(b);
+            }
+            break;
+        case 's': case 'S':
+            for(char b : std::string(" \t\r\n\f\v")) chars.set(static_cast<unsigned char>(b));
+            break;
+        default:
+            if(std::isalnum(static_cast<unsigned char>(c))){
+                throw std::runtime_error(std::string("Unsupported escape '\\") + c + "' in route pattern " + pattern);
+            }
+            chars.set(static_cast<unsigned char>(c));
+            return chars;
+    }
+    if(std::isupper(static_cast<unsigned char>(c))) chars.flip();
+    return chars;
+}
+
+/**
+ * @brief Extends a set of NFA states with every state reachable through epsilon transitions.
+ *
+ * @param states The states, replaced by their sorted closure.
+ */
+void PatternDFA::epsilonClosure(std::vector<int> &states){
+    std::vector<bool> visited(nfa.size(), false);
+    std::vector<int> stack(states);
+    states.clear();
+    while(!stack.empty()){
+        int state = stack.back();
+        stack.pop_back();
+        if(visited[state]) continue;
+        visited[state] = true;
+        states.push_back(state);
+        for(int next : nfa[state].epsilon){
+            if(!visited[next]) stack.push_back(next);
+        }
+    }
+    std::sort(states.begin(), states.end());
+}
+
+/**
+ * @brief Compiles all patterns into one DFA.
+ *
+ * @throw std::runtime_error if the patterns produce more than `maxDfaStates` DFA states.
+ */
+void PatternDFA::compile(){
+    nfa.clear();
+    transitions.clear();
+    acceptOffset.clear();
+    acceptedPatterns.clear();
+    if(patterns.empty()) return;
+
+    int start = addState();
+    for(std::size_t i = 0; i < patterns.size(); i++){
+        std::size_t pos = 0;
+        Fragment fragment = parseAlternation(patterns[i], pos);
+        int accept = addState();
+        nfa[accept].acceptPattern = static_cast<int>(i);
+        nfa[fragment.end].epsilon.push_back(accept);
+        nfa[start].epsilon.push_back(fragment.start);
+    }
+
+    // Split the bytes into classes that no transition distinguishes
+    std::memset(byteClass, 0, sizeof(byteClass));
+    classCount = 1;
+    for(const NfaState& state : nfa){
+        if(state.next < 0) continue;
+        int refinedClass[512];
+        std::fill(refinedClass, refinedClass + 512, -1);
+        int refinedCount = 0;
+        for(int b = 0; b < 256; b++){
+            int key = byteClass[b] * 2 + (state.chars[b] ? 1 : 0);
+            if(refinedClass[key] < 0) refinedClass[key] = refinedCount++;
+            byteClass[b] = static_cast<std::uint8_t>(refinedClass[key]);
+        }
+        classCount = refinedCount;
+    }
+    std::vector<int> representative(classCount);
+    for(int b = 255; b >= 0; b--){
+        representative[byteClass[b]] = b;
+    }
+
+    // Subset construction
+    std::map<std::vector<int>, int> dfaStateIds;
+    std::vector<std::vector<int>> dfaStates;
+
+    std::vector<int> initial{start};
+    epsilonClosure(initial);
+    dfaStateIds[initial] = 0;
+    dfaStates.push_back(initial);
+
+    for(std::size_t current = 0; current < dfaStates.size(); current++){
+        acceptOffset.push_back(static_cast<int>(acceptedPatterns.size()));
+        for(int state : dfaStates[current]){
+            if(nfa[state].acceptPattern >= 0) acceptedPatterns.push_back(nfa[state].acceptPattern);
+        }
+        std::sort(acceptedPatterns.begin() + acceptOffset.back(), acceptedPatterns.end());
+
+        for(int byteClassIndex = 0; byteClassIndex < classCount; byteClassIndex++){
+            std::vector<int> moved;
+            for(int state : dfaStates[current]){
+                if(nfa[state].next >= 0 && nfa[state].chars[representative[byteClassIndex]]){
+                    moved.push_back(nfa[state].next);
+                }
+            }
+            if(moved.empty()){
+                transitions.push_back(-1);
+                continue;
+            }
+            epsilonClosure(moved);
+            auto it = dfaStateIds.find(moved);
+            if(it == dfaStateIds.end()){
+                if(dfaStates.size() >= maxDfaStates){
+                    throw std::runtime_error("Route patterns are too complex to compile");
+                }
+                it = dfaStateIds.emplace(moved, static_cast<int>(dfaStates.size())).first;
+                dfaStates.push_back(moved);
+            }
+            transitions.push_back(it->second);
+        }
+    }
+
+    acceptOffset.push_back(static_cast<int>(acceptedPatterns.size()));
+
+    nfa.clear();
+    nfa.shrink_to_fit();
+}
+
+/**
+ * @brief Matches a path against all compiled patterns.
+ *
+ * @param path The request path.
+ * @return The indices of all patterns that match the whole path, in the order they were added.
+ *         Empty if none matches.
+ */
+PatternDFA::Matches PatternDFA::match(std::string_view path) const{
+    Matches matches;
+    if(transitions.empty()) return matches;
+    std::int32_t state = 0;
+    for(char c : path){
+        state = transitions[state * classCount + byteClass[static_cast<unsigned char>(c)]];
+        if(state < 0) return matches;
+    }
+    matches.first = acceptedPatterns.data() + acceptOffset[state];
+    matches.last = acceptedPatterns.data() + acceptOffset[state + 1];
+    return matches;
+}
+
+/**
+ * @brief Translates a glob pattern into a regular expression.
+ *
+ * `**` matches any text, `*` any text without '/', `?` one character other than '/', and
+ * `[...]` (or `[!...]` for negation, which never matches '/') a character class. Everything else
+ * matches literally.
+ *
+ * @param glob The glob pattern.
+ * @return The equivalent regular expression.
+ */
+std::string PatternDFA::globToRegex(const std::string &glob){
+    std::string regex;
+    for(std::size_t pos = 0; pos < glob.size(); pos++){
+        char c = glob[pos];
+        if(c == '*'){
+            if(pos + 1 < glob.size() && glob[pos + 1] == '*'){
+                regex += ".*";
+                pos++;
+            }
+            else{
+                regex += "[^/]*";
+            }
+        }
+        else if(c == '?'){
+            regex += "[^/]";
+        }
+        else if(c == '[' && glob.find(']', pos + 2) != std::string::npos){
+            std::size_t close = glob.find(']', pos + 2);
+            std::string content = glob.substr(pos + 1, close - pos - 1);
+            if(content[0] == '!') content.replace(0, 1, "^/");    // like '*' and '?', never match '/'
+            regex += "[" + content + "]";
+            pos = close;
+        }
+        else{
+            appendLiteral(regex, c);
+        }
+    }
+    return regex;
+}
+
+/**
+ * @brief Escapes text so that a regular expression matches it literally.
+ *
+ * @param text The text.
+ * @return The regular expression.
+ */
+std::string PatternDFA::escape(const std::string &text){
+    std::string regex;
+    for(char c : text){
+        appendLiteral(regex, c);
+    }
+    return regex;
+}
@@ -0,0 +1,84 @@
+#ifndef PATTERNDFA_H
+#define PATTERNDFA_H
+#include <bitset>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Matches a path against many regular expressions with a single scan.
+ *
+ * Patterns are added as regular expressions (glob patterns are translated with `globToRegex`).
+ * `compile()` turns every pattern into a Thompson NFA, joins them under one start state and
+ * converts the result into one DFA by subset construction. Input bytes are grouped into classes
+ * that no pattern distinguishes, which keeps the transition table small.
+ *
+ * `match()` then walks the table once over the path, so matching N patterns costs one lookup
+ * per path byte rather than N regex evaluations. Every pattern is anchored at both ends. When
+ * several patterns match, all of them are reported, in the order they were added.
+ */
+class PatternDFA{
+private:
+    struct NfaState {
+        std::bitset<256> chars;     ///< Bytes that lead to `next`
+        int next = -1;
+        std::vector<int> epsilon;   ///< States reachable without consuming a byte
+        int acceptPattern = -1;     ///< Index of the pattern this state accepts, -1 if not accepting
+    };
+
+    struct Fragment {
+        int start;
+        int end;
+    };
+
+    std::vector<std::string> patterns;
+
+    // Compiled automaton
+    std::uint8_t byteClass[256];        ///< Equivalence class of every input byte
+    int classCount;
+    std::vector<std::int32_t> transitions;  ///< stateCount x classCount, -1 for the dead state
+    std::vector<int> acceptOffset;       ///< Per DFA state, where its patterns start in acceptedPatterns, one extra entry at the end
+    std::vector<int> acceptedPatterns;   ///< The patterns accepted by each DFA state, in ascending order
+
+    // Only used while compiling
+    std::vector<NfaState> nfa;
+
+    int addState();
+    Fragment charFragment(const std::bitset<256>& chars);
+    Fragment parseAlternation(const std::string& pattern, std::size_t& pos);
+    Fragment parseConcatenation(const std::string& pattern, std::size_t& pos);
+    Fragment parseRepetition(const std::string& pattern, std::size_t& pos);
+    Fragment parseAtom(const std::string& pattern, std::size_t& pos);
+    std::bitset<256> parseClass(const std::string& pattern, std::size_t& pos);
+    std::bitset<256> parseEscape(const std::string& pattern, std::size_t& pos);
+    void epsilonClosure(std::vector<int>& states);
+
+public:
+    /**
+     * @brief The patterns that match a path, in the order they were added.
+     *
+     * Points into the compiled automaton, so it is only valid until the next `compile()`.
+     */
+    struct Matches {
+        const int* first = nullptr;
+        const int* last = nullptr;
+
+        const int* begin() const { return first; }
+        const int* end() const { return last; }
+        bool empty() const { return first == last; }
+    };
+
+    PatternDFA();
+
+    int add(const std::string& regex);
+    void compile();
+    Matches match(std::string_view path) const;
+
+    bool empty() const { return patterns.empty(); }
+
+    static std::string globToRegex(const std::string& glob);
+    static std::string escape(const std::string& text);
+};
+
+#endif
@@ -0,0 +1,67 @@
+#include <mutex>
+#include <unordered_set>
+
+#include "radixnode.h"
+
+/**
+ * @brief Gets a copy of a parameter name that lives as long as the program.
+ *
+ * Captured route parameters refer to their names, and a Request can outlive the route snapshot
+ * that matched it. Parameter names are few and only interned when routes are inserted.
+ *
+ * @param name The parameter name.
+ * @return A view of the interned name.
+ */
+static std::string_view internParamName(const std::string &name){
+    static std::mutex internMutex;
+    static std::unordered_set<std::string> paramNames;
+    std::lock_guard<std::mutex> lock(internMutex);
+    return *paramNames.insert(name).first;
+}
+
+/**
+ * @brief Constructs a new RadixNode without a route.
+ *
+ * @param type The kind of path piece the node matches (static text, parameter, wildcard or pattern).
+ * @param prefix The literal text for static nodes, the parameter name for parameter and wildcard nodes, or the regular expression for pattern nodes.
+ * @param parent The parent node, or nullptr for the root.
+ *
+ * The node starts without children and without response functions. The RadixTree sets the
+ * route, response functions and middleware when a route ending at this node is inserted.
+ */
+RadixNode::RadixNode(NodeType type, const std::string &prefix, RadixNode *parent): type(type), prefix(prefix), parent(parent), paramChild(nullptr), wildcardChild(nullptr), allowedMethods(0) {
+    if(type == PARAM || type == WILDCARD) paramName = internParamName(prefix);
+}
+
+/**
+ * @brief Destroys the node together with its whole subtree.
+ */
+RadixNode::~RadixNode(){
+    for(RadixNode* child : staticChildren){
+        delete child;
+    }
+    delete paramChild;
+    delete wildcardChild;
+}
+
+/**
+ * @brief Checks whether a route ends at this node.
+ *
+ * @return True if a response function is registered for at least one method.
+ */
+bool RadixNode::isRoute() const{
+    for(const std::shared_ptr<ResponseFunction>& responseFunction : responseFunctions){
+        if(responseFunction) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Checks whether a response function is registered for a method at this node.
+ *
+ * @param method The request method, HTTP_METHOD_COUNT for an unsupported method.
+ * @return True if the method is registered.
+ */
+bool RadixNode::handles(HttpMethod method) const{
+    return method != HTTP_METHOD_COUNT && responseFunctions[method] != nullptr;
+}
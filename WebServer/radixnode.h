@@ -0,0 +1,66 @@
+#ifndef RADIXNODE_H
+#define RADIXNODE_H
+#include <array>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "httpmethod.h"
+#include "response.h"
+#include "request.h"
+#include "middleware.h"
+#include "responsefunction.h"
+
+/**
+ * @brief Represents a node in the radix tree used for routing in the web server.
+ *
+ * Each node matches a piece of the request path. There are four kinds of nodes:
+ *   - static nodes match the literal text stored in `prefix`. Static siblings never share
+ *     a first character, common prefixes are split into a shared parent node (path compression).
+ *   - parameter nodes (`:name`) match one path segment, up to the next '/'.
+ *   - wildcard nodes (`*name`) match the remainder of the path and are always leaves.
+ *   - pattern nodes hold a glob or regex route. They are not linked into the tree, `prefix`
+ *     stores the compiled regular expression and the tree's PatternDFA matches them.
+ *
+ * A node that terminates a registered route stores the route and, for every HTTP method, the
+ * response function, its middleware and the complete middleware chain that runs before the
+ * response function, as well as the chain of after hooks that runs after it. A single lookup therefore resolves the path for all methods, and the
+ * set of registered methods answers requests for methods the route does not support.
+ * Nodes are owned by the RadixTree, which uses them internally for routing HTTP requests.
+ *
+ * @see RadixTree
+ */
+class RadixNode{
+private:
+    enum NodeType { STATIC, PARAM, WILDCARD, PATTERN };
+
+    NodeType type;
+    std::string prefix;     ///< Literal text for static nodes, parameter name for parameter and wildcard nodes, regular expression for pattern nodes
+    std::string_view paramName;     ///< The parameter name of parameter and wildcard nodes, interned so that captured parameters outlive the tree
+    RadixNode* parent;
+
+    std::string indices;    ///< First character of every static child, in the same order as staticChildren
+    std::vector<RadixNode*> staticChildren;
+    RadixNode* paramChild;
+    RadixNode* wildcardChild;
+
+    std::string route;      ///< The registered route, empty if no route ends at this node
+    std::array<std::shared_ptr<ResponseFunction>, HTTP_METHOD_COUNT> responseFunctions;   ///< Response function per method, null if the method is not registered
+    std::array<Middleware, HTTP_METHOD_COUNT> middleware;  ///< Middleware registered with each method
+    std::vector<Middleware> groupMiddleware;   ///< Middleware of the route groups mounted at this node, outermost first, runs for every method of every route at or below it
+    std::array<std::vector<MiddlewareFunction*>, HTTP_METHOD_COUNT> middlewareChains;   ///< Middleware of all parent routes and groups followed by this route's own, per method, resolved by RadixTree::freeze
+    std::array<std::vector<AfterHook*>, HTTP_METHOD_COUNT> afterHookChains;   ///< This route's after hooks followed by those of its groups and parent routes, innermost first, per method, resolved by RadixTree::freeze
+    unsigned allowedMethods;    ///< One bit per registered method, indexed by HttpMethod, resolved by RadixTree::freeze
+
+    RadixNode(NodeType type, const std::string& prefix, RadixNode* parent);
+    ~RadixNode();
+
+    bool isRoute() const;
+    bool handles(HttpMethod method) const;
+
+    friend class RadixTree;
+    friend class RouteMatch;
+    friend class WebServer;
+};
+
+#endif
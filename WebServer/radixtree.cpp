@@ -0,0 +1,576 @@
+#include <stdexcept>
+
+#include "radixtree.h"
+#include "middleware.h"
+#include "response.h"
+
+RadixTree::RadixTree():root(new RadixNode(RadixNode::STATIC, "", nullptr)), frozen(true){}
+
+RadixTree::~RadixTree(){
+    delete root;
+    for(RadixNode* patternNode : patternNodes){
+        delete patternNode;
+    }
+}
+
+/**
+ * @brief Inserts static text below a node, splitting existing nodes where the text diverges.
+ *
+ * @param node The node below which the text is inserted.
+ * @param text The static text to insert.
+ * @return The node at which the text ends.
+ */
+RadixNode *RadixTree::insertStatic(RadixNode *node, const std::string &text){
+    std::string remaining = text;
+    while(!remaining.empty()){
+        std::string::size_type index = node->indices.find(remaining[0]);
+        if(index == std::string::npos){
+            RadixNode* child = new RadixNode(RadixNode::STATIC, remaining, node);
+            node->indices.push_back(remaining[0]);
+            node->staticChildren.push_back(child);
+            return child;
+        }
+
+        RadixNode* child = node->staticChildren[index];
+        std::string::size_type common = 0;
+        while(common < child->prefix.size() && common < remaining.size() && child->prefix[common] == remaining[common]){
+            common++;
+        }
+
+        if(common < child->prefix.size()){
+            // Split the child: the shared part becomes a new node with the old child below it
+            RadixNode* shared = new RadixNode(RadixNode::STATIC, child->prefix.substr(0, common), node);
+            child->prefix = child->prefix.substr(common);
+            child->parent = shared;
+            shared->indices.push_back(child->prefix[0]);
+            shared->staticChildren.push_back(child);
+            node->staticChildren[index] = shared;
+            child = shared;
+        }
+
+        node = child;
+        remaining = remaining.substr(common);
+    }
+    return node;
+}
+
+void RadixTree::insert(HttpMethod method, const RoutePattern &route, std::shared_ptr<ResponseFunction> responseFunction){
+    Middleware middleware;
+    insert(method, route, std::move(responseFunction), middleware);
+}
+
+/**
+ * @brief Inserts the nodes of a tree route.
+ *
+ * A `:` or `*` at the start of a path segment begins a parameter or a wildcard, any other
+ * character is matched literally.
+ *
+ * @param route The route.
+ * @return The node at which the route ends.
+ * @throw std::runtime_error if two routes use different names for the same parameter position, if a wildcard
+ *        is not the last segment or if the route has more than `RouteParams::capacity` parameters.
+ */
+RadixNode *RadixTree::insertPath(const std::string &route){
+    RadixNode* node = root;
+    std::string path = route;
+    std::size_t paramCount = 0;
+
+    while(!path.empty()){
+        if((path[0] == ':' || path[0] == '*') && ++paramCount > RouteParams::capacity){
+            throw std::runtime_error("Too many parameters in route " + route);
+        }
+        if(path[0] == ':'){
+            std::string::size_type end = path.find('/');
+            std::string name = path.substr(1, end == std::string::npos ? std::string::npos : end - 1);
+            if(name.empty()){
+                throw std::runtime_error("Unnamed route parameter in route " + route);
+            }
+            if(!node->paramChild){
+                node->paramChild = new RadixNode(RadixNode::PARAM, name, node);
+            }
+            else if(node->paramChild->prefix != name){
+                std::cerr << "Conflicting parameter names :" << node->paramChild->prefix << " and :" << name << " in route " << route << std::endl;
+                throw std::runtime_error("Conflicting route parameter names");
+            }
+            node = node->paramChild;
+            path = (end == std::string::npos) ? "" : path.substr(end);
+        }
+        else if(path[0] == '*'){
+            std::string name = path.substr(1);
+            if(name.find('/') != std::string::npos){
+                throw std::runtime_error("Wildcard must be the last segment of route " + route);
+            }
+            if(name.empty()) name = "*";
+            if(!node->wildcardChild){
+                node->wildcardChild = new RadixNode(RadixNode::WILDCARD, name, node);
+            }
+            else if(node->wildcardChild->prefix != name){
+                std::cerr << "Conflicting wildcard names *" << node->wildcardChild->prefix << " and *" << name << " in route " << route << std::endl;
+                throw std::runtime_error("Conflicting route wildcard names");
+            }
+            node = node->wildcardChild;
+            path = "";
+        }
+        else{
+            // Static text runs up to the next segment that starts with ':' or '*'
+            std::string::size_type end = 1;
+            while(end < path.size() && !(path[end - 1] == '/' && (path[end] == ':' || path[end] == '*'))){
+                end++;
+            }
+            node = insertStatic(node, path.substr(0, end));
+            path = path.substr(end);
+        }
+    }
+
+    return node;
+}
+
+/**
+ * @brief Finds or creates the node of a glob or regex route.
+ *
+ * @param regex The route as a regular expression.
+ * @return The node of the route.
+ * @throw std::runtime_error if the regular expression is invalid.
+ */
+RadixNode *RadixTree::insertPattern(const std::string &regex){
+    for(RadixNode* patternNode : patternNodes){
+        if(patternNode->prefix == regex) return patternNode;
+    }
+    patternDFA.add(regex);
+    RadixNode* patternNode = new RadixNode(RadixNode::PATTERN, regex, nullptr);
+    patternNodes.push_back(patternNode);
+    return patternNode;
+}
+
+/**
+ * @brief Inserts a route together with its response function and middleware for one method.
+ *
+ * Plain routes are inserted into the tree, glob and regex routes are added to the pattern DFA.
+ *
+ * @throw std::runtime_error if the route is already defined for the method, if two routes use different names
+ *        for the same parameter position, if a wildcard is not the last segment, if a route has too many
+ *        parameters or if a pattern is invalid.
+ */
+void RadixTree::insert(HttpMethod method, const RoutePattern &route, std::shared_ptr<ResponseFunction> responseFunction, Middleware &middleware){
+    RadixNode* node;
+    switch(route.getKind()){
+        case RoutePattern::GLOB:
+            node = insertPattern(PatternDFA::globToRegex(route.getPattern()));
+            break;
+        case RoutePattern::REGEX:
+            node = insertPattern(route.getPattern());
+            break;
+        default:
+            node = insertPath(route.getPattern());
+            break;
+    }
+
+    setRoute(node, method, route.getPattern(), std::move(responseFunction), middleware);
+}
+
+/**
+ * @brief Registers a response function and its middleware for one method on a route's node.
+ *
+ * @throw std::runtime_error if the node already has a response function for the method.
+ */
+void RadixTree::setRoute(RadixNode *node, HttpMethod method, const std::string &route, std::shared_ptr<ResponseFunction> responseFunction, Middleware &middleware){
+    if(node->responseFunctions[method]){
+        std::cerr << "Two definitions for the same route not permitted : "<<httpMethodName(method)<<" "<<node->route<<std::endl;
+        throw std::runtime_error("Two definitions for the same route");
+    }
+    node->route = route;
+    node->responseFunctions[method] = std::move(responseFunction);
+    node->middleware[method] = middleware;
+    frozen = false;
+}
+
+/**
+ * @brief Mounts a route group and its subgroups.
+ *
+ * The group prefix is inserted once and the group middleware stored on its node. The routes
+ * are inserted below it. The group middleware runs for the routes at or below the prefix, up to
+ * a path segment boundary: a group mounted at `/api` covers `/api` and `/api/users`, not
+ * `/apiary`. Glob and regex routes are not part of the tree: their regular expression starts
+ * with the escaped prefix and they carry the middleware of all enclosing groups themselves.
+ *
+ * @param group The group.
+ * @param parentPrefix The prefix of the enclosing groups.
+ * @param enclosingGroupMiddleware The middleware of the enclosing groups, outermost first.
+ * @throw std::runtime_error if a route is already defined or invalid, or if a glob or regex route is
+ *        mounted below a prefix that contains a parameter.
+ */
+void RadixTree::mount(const RouteGroup &group, const std::string &parentPrefix, const std::vector<Middleware> &enclosingGroupMiddleware){
+    std::string prefix = parentPrefix + group.prefix;
+    RadixNode* groupNode = insertPath(prefix);
+    groupNode->groupMiddleware.push_back(group.middleware);
+    frozen = false;
+
+    std::vector<Middleware> groupMiddleware(enclosingGroupMiddleware);
+    groupMiddleware.push_back(group.middleware);
+
+    for(const RouteGroup::GroupRoute& groupRoute : group.routes){
+        Middleware routeMiddleware = groupRoute.middleware;
+        const std::string& pattern = groupRoute.route.getPattern();
+        if(groupRoute.route.getKind() == RoutePattern::PATH){
+            insert(groupRoute.method, RoutePattern(prefix + pattern), groupRoute.responseFunction, routeMiddleware);
+            continue;
+        }
+
+        if(prefix.find("/:") != std::string::npos || prefix.find("/*") != std::string::npos){
+            throw std::runtime_error("Glob and regex routes cannot be mounted below a route parameter: " + prefix);
+        }
+        std::string regex = PatternDFA::escape(prefix);
+        if(groupRoute.route.getKind() == RoutePattern::GLOB){
+            regex += PatternDFA::globToRegex(pattern);
+        }
+        else{
+            regex += (!pattern.empty() && pattern[0] == '^') ? pattern.substr(1) : pattern;
+        }
+        RadixNode* patternNode = insertPattern(regex);
+        patternNode->groupMiddleware = groupMiddleware;
+        setRoute(patternNode, groupRoute.method, prefix + pattern, groupRoute.responseFunction, routeMiddleware);
+    }
+
+    for(const RouteGroup& subgroup : group.subgroups){
+        mount(subgroup, prefix, groupMiddleware);
+    }
+}
+
+/**
+ * @brief Mounts a route group at its prefix.
+ *
+ * @param group The group.
+ * @throw std::runtime_error if a route of the group is already defined or invalid.
+ */
+void RadixTree::mount(const RouteGroup &group){
+    mount(group, "", std::vector<Middleware>());
+}
+
+/**
+ * @brief Adds global middleware, which runs for every route.
+ *
+ * Its middleware functions run before those of all groups and routes, its after hooks after all
+ * others. Global middleware added earlier runs first.
+ *
+ * @param middleware The middleware, which is copied.
+ */
+void RadixTree::use(const Middleware &middleware){
+    globalMiddleware.push_back(middleware);
+    frozen = false;
+}
+
+/**
+ * @brief Resolves the middleware chains, after hook chains and registered methods of a subtree.
+ *
+ * Group middleware stored on a node applies to the node and to the children below its path
+ * segment boundary only. A static child that continues the node's last segment, e.g. `/apiary`
+ * below a group mounted at `/api`, inherits the chains without it.
+ *
+ * @param node The root of the subtree.
+ * @param inheritedChains Per method, the chain of the nearest group or route registered for that method above the node.
+ * @param inheritedAfterHooks Per method, the after hooks of the nearest group or route registered for that method above the node.
+ */
+void RadixTree::freeze(RadixNode *node, const std::array<const std::vector<MiddlewareFunction*>*, HTTP_METHOD_COUNT> &inheritedChains,
+                       const std::array<const std::vector<AfterHook*>*, HTTP_METHOD_COUNT> &inheritedAfterHooks){
+    std::array<const std::vector<MiddlewareFunction*>*, HTTP_METHOD_COUNT> chains = inheritedChains;
+    std::array<const std::vector<AfterHook*>*, HTTP_METHOD_COUNT> afterHooks = inheritedAfterHooks;
+    // Chains without the node's group middleware, for children that continue its last path segment
+    std::array<const std::vector<MiddlewareFunction*>*, HTTP_METHOD_COUNT> segmentChains = inheritedChains;
+    std::array<const std::vector<AfterHook*>*, HTTP_METHOD_COUNT> segmentAfterHooks = inheritedAfterHooks;
+    std::array<std::vector<MiddlewareFunction*>, HTTP_METHOD_COUNT> routeChains;
+    std::array<std::vector<AfterHook*>, HTTP_METHOD_COUNT> routeAfterHooks;
+    node->allowedMethods = 0;
+    for(int method = 0; method < HTTP_METHOD_COUNT; method++){
+        bool isRoute = node->responseFunctions[method] != nullptr;
+        if(!isRoute && node->groupMiddleware.empty()) continue;
+
+        std::vector<MiddlewareFunction*>& chain = node->middlewareChains[method];
+        chain = *inheritedChains[method];
+        for(const Middleware& group : node->groupMiddleware){
+            for(const std::shared_ptr<MiddlewareFunction>& middlewareFunction : group.listOfMiddlewareFunctions){
+                chain.push_back(middlewareFunction.get());
+            }
+        }
+
+        // After hooks unwind in reverse: the route's own, then its groups innermost first, then the inherited ones
+        std::vector<AfterHook*>& afterHookChain = node->afterHookChains[method];
+        afterHookChain.clear();
+        if(isRoute){
+            for(const std::shared_ptr<AfterHook>& afterHook : node->middleware[method].listOfAfterHooks){
+                afterHookChain.push_back(afterHook.get());
+            }
+        }
+        for(auto group = node->groupMiddleware.rbegin(); group != node->groupMiddleware.rend(); group++){
+            for(const std::shared_ptr<AfterHook>& afterHook : group->listOfAfterHooks){
+                afterHookChain.push_back(afterHook.get());
+            }
+        }
+        afterHookChain.insert(afterHookChain.end(), inheritedAfterHooks[method]->begin(), inheritedAfterHooks[method]->end());
+
+        chains[method] = &chain;
+        afterHooks[method] = &afterHookChain;
+        if(!isRoute) continue;
+
+        for(const std::shared_ptr<MiddlewareFunction>& middlewareFunction : node->middleware[method].listOfMiddlewareFunctions){
+            chain.push_back(middlewareFunction.get());
+        }
+
+        if(!node->groupMiddleware.empty()){
+            routeChains[method] = *inheritedChains[method];
+            for(const std::shared_ptr<MiddlewareFunction>& middlewareFunction : node->middleware[method].listOfMiddlewareFunctions){
+                routeChains[method].push_back(middlewareFunction.get());
+            }
+            for(const std::shared_ptr<AfterHook>& afterHook : node->middleware[method].listOfAfterHooks){
+                routeAfterHooks[method].push_back(afterHook.get());
+            }
+            routeAfterHooks[method].insert(routeAfterHooks[method].end(), inheritedAfterHooks[method]->begin(), inheritedAfterHooks[method]->end());
+            segmentChains[method] = &routeChains[method];
+            segmentAfterHooks[method] = &routeAfterHooks[method];
+        }
+        else{
+            segmentChains[method] = &chain;
+            segmentAfterHooks[method] = &afterHookChain;
+        }
+
+        node->allowedMethods |= 1u << method;
+    }
+
+    // Parameter nodes end at a '/', as does a static node whose text ends with one, and the root
+    bool endsSegment = node->type != RadixNode::STATIC || node->prefix.empty() || node->prefix.back() == '/';
+    for(RadixNode* child : node->staticChildren){
+        if(endsSegment || child->prefix[0] == '/'){
+            freeze(child, chains, afterHooks);
+        }
+        else{
+            freeze(child, segmentChains, segmentAfterHooks);
+        }
+    }
+    if(node->paramChild) freeze(node->paramChild, chains, afterHooks);
+    if(node->wildcardChild) freeze(node->wildcardChild, chains, afterHooks);
+}
+
+/**
+ * @brief Resolves the middleware chains and registered methods of every route.
+ *
+ * For every method, a route's chain consists of the global middleware, the middleware of all routes
+ * above it in the tree registered for that method and of all groups mounted above it or at its
+ * node, parents first, followed by its own middleware. It is stored as a flat array on the route's
+ * node, together with the chain of after hooks, composed in the reverse order, and the
+ * set of methods registered on it. Glob and regex routes only run the global middleware, their
+ * groups' and their own, and are compiled into the pattern DFA. Called by
+ * WebServer::run() once all routes are registered, and again by search() if routes were inserted since.
+ *
+ * @throw std::runtime_error if the glob and regex routes are too complex to compile.
+ */
+void RadixTree::freeze(){
+    std::vector<MiddlewareFunction*> globalChain;
+    std::vector<AfterHook*> globalAfterHooks;
+    for(const Middleware& middleware : globalMiddleware){
+        for(const std::shared_ptr<MiddlewareFunction>& middlewareFunction : middleware.listOfMiddlewareFunctions){
+            globalChain.push_back(middlewareFunction.get());
+        }
+    }
+    for(auto middleware = globalMiddleware.rbegin(); middleware != globalMiddleware.rend(); middleware++){
+        for(const std::shared_ptr<AfterHook>& afterHook : middleware->listOfAfterHooks){
+            globalAfterHooks.push_back(afterHook.get());
+        }
+    }
+    std::array<const std::vector<MiddlewareFunction*>*, HTTP_METHOD_COUNT> rootChains;
+    rootChains.fill(&globalChain);
+    std::array<const std::vector<AfterHook*>*, HTTP_METHOD_COUNT> rootAfterHooks;
+    rootAfterHooks.fill(&globalAfterHooks);
+    freeze(root, rootChains, rootAfterHooks);
+    for(RadixNode* patternNode : patternNodes){
+        freeze(patternNode, rootChains, rootAfterHooks);
+    }
+    patternDFA.compile();
+    frozen = true;
+}
+
+/**
+ * @brief Matches the remaining path below a node.
+ *
+ * Static children are tried first, then the parameter child, then the wildcard child.
+ * If a branch fails further down, or only matches routes that are not registered for the
+ * method, the parameters it captured are dropped and the next kind of child is tried.
+ * The routes that match the path but not the method are collected for the `Allow` header.
+ *
+ * @param node The node matched so far.
+ * @param path The part of the request path that is not matched yet.
+ * @param method The request method, HTTP_METHOD_COUNT for an unsupported method.
+ * @param routeParams Receives the captured parameters.
+ * @param pathMatch Receives the first route that matches the path but is not registered for the method.
+ * @param allowedMethods Receives the methods registered on every route that matches the path.
+ * @return The node of the matching route registered for the method, or nullptr if there is none.
+ */
+RadixNode *RadixTree::search(RadixNode *node, std::string_view path, HttpMethod method, RouteParams &routeParams, RadixNode *&pathMatch, unsigned &allowedMethods){
+    if(path.empty()){
+        if(node->handles(method)) return node;
+        if(node->isRoute()){
+            if(!pathMatch) pathMatch = node;
+            allowedMethods |= node->allowedMethods;
+        }
+    }
+    else{
+        std::string::size_type index = node->indices.find(path[0]);
+        if(index != std::string::npos){
+            RadixNode* child = node->staticChildren[index];
+            if(path.substr(0, child->prefix.size()) == child->prefix){
+                RadixNode* found = search(child, path.substr(child->prefix.size()), method, routeParams, pathMatch, allowedMethods);
+                if(found) return found;
+            }
+        }
+
+        if(node->paramChild){
+            std::string_view segment = path.substr(0, path.find('/'));
+            if(!segment.empty()){
+                std::size_t capturedParams = routeParams.size();
+                routeParams.push_back(node->paramChild->paramName, segment);
+                RadixNode* found = search(node->paramChild, path.substr(segment.size()), method, routeParams, pathMatch, allowedMethods);
+                if(found) return found;
+                routeParams.truncate(capturedParams);
+            }
+        }
+    }
+
+    RadixNode* wildcard = node->wildcardChild;
+    if(wildcard){
+        if(wildcard->handles(method)){
+            routeParams.push_back(wildcard->paramName, path);
+            return wildcard;
+        }
+        if(wildcard->isRoute()){
+            if(!pathMatch) pathMatch = wildcard;
+            allowedMethods |= wildcard->allowedMethods;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Finds the route that matches the request.
+ *
+ * The parameters captured by the route are also stored on the request.
+ *
+ * @param requestObject The request.
+ * @return The match. If the path matches but the method is not registered, the match is found without
+ *         a response function and its `Allow` header lists the methods that are.
+ */
+RouteMatch RadixTree::search(Request &requestObject){
+    RouteMatch routeMatch = search(parseHttpMethod(requestObject.getRequestType()), requestObject.getRequestRoute());
+    requestObject.routeParams = routeMatch.routeParams;
+    return routeMatch;
+}
+
+/**
+ * @brief Finds the route that matches a method and path.
+ *
+ * Tree routes take precedence. If none is registered for the method, the glob and regex routes
+ * are tried, and among those that are registered for the method the first one added wins. A
+ * route that matches the path but not the method never hides another route that matches both:
+ * the match only lacks a response function if no route matching the path is registered for the
+ * method, and its `Allow` header then lists the methods of all of them. The lookup does not
+ * allocate: the match is returned by value and the parameters are views into the interned
+ * parameter names and `path`.
+ *
+ * @param method The request method, HTTP_METHOD_COUNT for an unsupported method.
+ * @param path The request path, without the query string.
+ * @return The match.
+ */
+RouteMatch RadixTree::search(HttpMethod method, std::string_view path){
+    if(!frozen) freeze();
+    RouteMatch routeMatch;
+    routeMatch.method = method;
+    RadixNode* pathMatch = nullptr;
+    routeMatch.node = search(root, path, method, routeMatch.routeParams, pathMatch, routeMatch.allowedMethods);
+    if(!routeMatch.node){
+        routeMatch.routeParams.clear();
+        for(int pattern : patternDFA.match(path)){
+            RadixNode* patternNode = patternNodes[pattern];
+            routeMatch.allowedMethods |= patternNode->allowedMethods;
+            if(patternNode->handles(method)){
+                routeMatch.node = patternNode;
+                break;
+            }
+            if(!pathMatch) pathMatch = patternNode;
+        }
+        if(!routeMatch.node){
+            routeMatch.node = pathMatch;
+            return routeMatch;
+        }
+    }
+    routeMatch.allowedMethods |= routeMatch.node->allowedMethods;
+    routeMatch.responseFunction = routeMatch.node->responseFunctions[method].get();
+    return routeMatch;
+}
+
+/**
+ * @brief Resolves the node that serves each route of the static route table.
+ *
+ * A route is only bound if the tree serves it itself, without parameters. A route that was
+ * removed, or that another route now answers, is left unbound and searched in the tree instead.
+ *
+ * @param staticRoutes The routes of the table, in the table's order.
+ */
+void RadixTree::bindStaticRoutes(const std::vector<StaticRoute> &staticRoutes){
+    staticRouteNodes.assign(staticRoutes.size(), nullptr);
+    for(std::size_t i = 0; i < staticRoutes.size(); i++){
+        RouteMatch routeMatch = search(staticRoutes[i].method, staticRoutes[i].route);
+        if(routeMatch.methodAllowed() && routeMatch.routeParams.empty() && routeMatch.node->route == staticRoutes[i].route){
+            staticRouteNodes[i] = routeMatch.node;
+        }
+    }
+}
+
+/**
+ * @brief Gets the match of a route of the static route table without searching the tree.
+ *
+ * @param staticRoute The index of the route in the table, as found by its perfect hash.
+ * @param method The request method.
+ * @return The match, not found if the index is out of range or the route is not bound, see bindStaticRoutes.
+ */
+RouteMatch RadixTree::searchStatic(std::size_t staticRoute, HttpMethod method){
+    RouteMatch routeMatch;
+    if(staticRoute >= staticRouteNodes.size() || !staticRouteNodes[staticRoute]) return routeMatch;
+    routeMatch.method = method;
+    routeMatch.node = staticRouteNodes[staticRoute];
+    routeMatch.allowedMethods = routeMatch.node->allowedMethods;
+    routeMatch.responseFunction = routeMatch.node->responseFunctions[method].get();
+    return routeMatch;
+}
+
+/**
+ * @brief Runs the middleware chain of a matched route for the request method.
+ *
+ * The chain contains the middleware of parent routes first. Execution stops at the first
+ * middleware function that returns a Response instead of `Middleware::next()`, and that response
+ * is stored in the match.
+ *
+ * @param routeMatch A match whose method is registered on the route.
+ * @param requestObject The request passed to the middleware functions.
+ */
+void RadixTree::executeMiddleware(RouteMatch &routeMatch, Request &requestObject){
+    for(MiddlewareFunction* middlewareFunction : routeMatch.node->middlewareChains[routeMatch.method]){
+        MiddlewareResult result = (*middlewareFunction)(requestObject);
+        if(!result.isNext()){
+            routeMatch.middlewareResponse = std::move(result.response);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Runs the after hooks of a matched route on the response of its response function.
+ *
+ * The route's own after hooks run first, then those of its groups and parent routes. A route
+ * without after hooks has an empty chain, so this costs nothing.
+ *
+ * @param routeMatch A match whose method is registered on the route.
+ * @param requestObject The request passed to the after hooks.
+ * @param responseObject The response of the response function, modified in place.
+ */
+void RadixTree::executeAfterHooks(const RouteMatch &routeMatch, Request &requestObject, Response &responseObject){
+    for(AfterHook* afterHook : routeMatch.node->afterHookChains[routeMatch.method]){
+        (*afterHook)(requestObject, responseObject);
+    }
+}
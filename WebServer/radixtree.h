@@ -0,0 +1,93 @@
+#ifndef RADIXTREE_H
+#define RADIXTREE_H
+#include "radixnode.h"
+#include "patterndfa.h"
+#include "routepattern.h"
+#include "routematch.h"
+#include "routegroup.h"
+#include "staticroutetable.h"
+#include <string>
+#include <string_view>
+
+/**
+ * @brief A compressed prefix tree (radix tree) that maps request paths to routes.
+ *
+ * Routes may contain three kinds of segments:
+ *   - static text, e.g. `/about`
+ *   - named parameters that capture one path segment, e.g. `/users/:id`
+ *   - a trailing wildcard `*name` that captures the rest of the path, e.g. after `/files/`
+ *
+ * Static text is preferred over parameters, and parameters over wildcards. The cost of a lookup
+ * depends on the length of the request path, not on the number of registered routes. All HTTP
+ * methods share one tree: a lookup resolves the path, and the node holds one response function per method.
+ * A route that matches the path but is not registered for the method does not end the lookup, the
+ * other branches are still searched for a route that is.
+ * A lookup returns a RouteMatch by value and performs no heap allocation. Captured values are
+ * stored on the Request and can be read with `Request::getRouteParam`.
+ *
+ * Middleware registered on a route also applies to every route below it in the tree, i.e. every
+ * route it is a prefix of, for the same method. The complete chain of each route is resolved once by `freeze()`, so a
+ * request runs exactly the functions of its own chain without walking the tree. After hooks are
+ * composed the same way in reverse: a route's own run first, those of its groups and parents after.
+ *
+ * Route groups (see RouteGroup) are mounted as the subtree below their prefix node, which holds the
+ * group middleware. `freeze()` composes it into the chain of every route at the prefix or below
+ * `prefix + "/"`, for all methods. Routes that merely share the prefix text, like `/apiary` next to
+ * a group mounted at `/api`, do not run it.
+ * Global middleware (see `use()`) is composed into the chain of every route in the same way.
+ *
+ * The routes of a static route table (see StaticRouteTable) are inserted like any other route.
+ * `bindStaticRoutes()` resolves the node of each of them once, so that a table hit skips the tree
+ * search but runs the same chains as a tree lookup would.
+ *
+ * Glob and regex routes (see RoutePattern) are kept outside the tree and compiled together into one
+ * PatternDFA by `freeze()`. They are only consulted when no tree route matching the path is
+ * registered for the method, and run their own middleware only.
+ */
+class RadixTree{
+private:
+    RadixNode* root;
+    bool frozen;    ///< Whether the middleware chains and the pattern DFA are up to date with the inserted routes
+
+    std::vector<Middleware> globalMiddleware;   ///< Runs for every route, before all other middleware
+    std::vector<RadixNode*> patternNodes;   ///< Glob and regex routes, indexed like the patterns of patternDFA
+    PatternDFA patternDFA;
+    std::vector<RadixNode*> staticRouteNodes;   ///< The node serving each route of the static route table, indexed like the table, nullptr if the tree must be searched
+
+    RadixNode* insertStatic(RadixNode* node, const std::string& text);
+    RadixNode* insertPath(const std::string& route);
+    RadixNode* insertPattern(const std::string& regex);
+    void setRoute(RadixNode* node, HttpMethod method, const std::string& route, std::shared_ptr<ResponseFunction> responseFunction, Middleware &middleware);
+    void mount(const RouteGroup& group, const std::string& parentPrefix, const std::vector<Middleware>& enclosingGroupMiddleware);
+
+    RadixNode* search(RadixNode* node, std::string_view path, HttpMethod method, RouteParams& routeParams, RadixNode*& pathMatch, unsigned& allowedMethods);
+
+    void freeze(RadixNode* node, const std::array<const std::vector<MiddlewareFunction*>*, HTTP_METHOD_COUNT>& inheritedChains,
+                const std::array<const std::vector<AfterHook*>*, HTTP_METHOD_COUNT>& inheritedAfterHooks);
+
+public:
+    RadixTree();
+    ~RadixTree();
+    RadixTree(const RadixTree&) = delete;
+    RadixTree& operator=(const RadixTree&) = delete;
+
+    void insert(HttpMethod method, const RoutePattern& route, std::shared_ptr<ResponseFunction> responseFunction);
+    void insert(HttpMethod method, const RoutePattern& route, std::shared_ptr<ResponseFunction> responseFunction, Middleware &middleware);
+
+    void mount(const RouteGroup& group);
+    void use(const Middleware& middleware);
+
+    void freeze();
+
+    RouteMatch search(Request &requestObject);
+    RouteMatch search(HttpMethod method, std::string_view path);
+
+    void bindStaticRoutes(const std::vector<StaticRoute>& staticRoutes);
+    RouteMatch searchStatic(std::size_t staticRoute, HttpMethod method);
+
+    void executeMiddleware(RouteMatch &routeMatch, Request &requestObject);
+    void executeAfterHooks(const RouteMatch &routeMatch, Request &requestObject, Response &responseObject);
+};
+
+
+#endif
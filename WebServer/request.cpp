@@ -3,7 +3,12 @@
 #include <sstream>
 #include <iostream>
 #include <stdexcept>
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <limits>
 #include "nlohmann/json.hpp"
+#include "httpdate.h"
 
 /**
  * @brief Private constructor to parse a raw HTTP request.
@@ -20,7 +25,9 @@ Request::Request(std::string& rawRequest){
 /**
  * @brief Parses the raw HTTP request string.
  *
- * This method extracts the request type, route, query parameters, and body from the raw request string.
+ * This method extracts the request type, route, query parameters and headers from the raw request string.
+ * Any bytes following the header section are kept in rawBody; the body itself is parsed by the WebServer
+ * once it has been received completely (see WebServer::receiveRequestBody).
  *
  * @param rawRequest The raw HTTP request string.
  */
@@ -39,20 +46,146 @@ void Request::parseRequest(std::string &rawRequest){
         parseQueryParameters(queryString);
     }
     while (std::getline(requestStream, line) && !line.empty() && line != "\r") {
-        if (line.find("Content-Type:") != std::string::npos) {
-            contentType = line.substr(line.find(":") + 2);
-            if(contentType[contentType.length()-1]=='\r'){
-                contentType = contentType.substr(0,contentType.length()-1);
-            }
+        if(line[line.length()-1] == '\r'){
+            line = line.substr(0, line.length()-1);
+        }
+        std::string::size_type colonPos = line.find(':');
+        if (colonPos == std::string::npos) continue;
+
+        std::string headerName = line.substr(0, colonPos);
+        std::transform(headerName.begin(), headerName.end(), headerName.begin(), [](unsigned char c){ return std::tolower(c); });
+        std::string::size_type valuePos = line.find_first_not_of(" \t", colonPos + 1);
+        requestHeaders[headerName] = (valuePos == std::string::npos) ? "" : line.substr(valuePos);
+    }
+
+    contentType = getRequestHeader("content-type");
+    const std::string& contentLengthHeader = getRequestHeader("content-length");
+    if (!contentLengthHeader.empty()) {
+        // Only digits are accepted, std::stoul would wrap "-1" around to a huge length
+        std::string_view lengthDigits(contentLengthHeader);
+        lengthDigits.remove_suffix(lengthDigits.size() - (lengthDigits.find_last_not_of(" \t") + 1));
+        std::from_chars_result lengthEnd = std::from_chars(lengthDigits.data(), lengthDigits.data() + lengthDigits.size(), contentLength);
+        if (lengthDigits.empty() || lengthEnd.ptr != lengthDigits.data() + lengthDigits.size()) {
+            contentLength = 0;
+            contentLengthValid = false;
+        }
+        else if (lengthEnd.ec == std::errc::result_out_of_range) {
+            contentLength = std::numeric_limits<std::size_t>::max();
         }
     }
-    if (requestType == "POST" || requestType == "PUT" || requestType == "PATCH" || requestType == "DELETE") {
-        std::stringstream bodyStream;
-        bodyStream << requestStream.rdbuf(); 
-        std::string body = bodyStream.str();
-        parseRequestBody(body);
+
+    std::stringstream bodyStream;
+    bodyStream << requestStream.rdbuf();
+    rawBody = bodyStream.str();
+}
+
+/**
+ * @brief Gets the value of a request header.
+ *
+ * @param headerName The lower-case name of the header (e.g., "content-type").
+ * @return The header value, or an empty string if the header is not present.
+ */
+const std::string& Request::getRequestHeader(const std::string &headerName) const{
+    static const std::string emptyHeader;
+    auto it = requestHeaders.find(headerName);
+    if (it == requestHeaders.end()) return emptyHeader;
+    return it->second;
+}
+
+/**
+ * @brief Gets the value of a parameter captured by the matched route.
+ *
+ * @param paramName The parameter name as written in the route, without the leading ':' or '*'.
+ *                  An unnamed trailing wildcard is called "*".
+ * @return A view of the captured value, or an empty view if the route has no such parameter.
+ */
+std::string_view Request::getRouteParam(std::string_view paramName) const{
+    for (const auto& param : routeParams) {
+        if (param.first == paramName) return param.second;
     }
+    return std::string_view();
+}
+
+/**
+ * @brief Removes the weakness indicator `W/` of an entity tag.
+ */
+static std::string_view opaqueTag(std::string_view etag){
+    if(etag.size() >= 2 && etag[0] == 'W' && etag[1] == '/') etag.remove_prefix(2);
+    return etag;
+}
 
+/**
+ * @brief Checks whether the client's cached copy of a response is still current (a conditional GET).
+ *
+ * If the request carries `If-None-Match`, its entity tags are compared with the ETag of the
+ * response using the weak comparison of RFC 9110, and `If-Modified-Since` is ignored. Otherwise
+ * the date of `If-Modified-Since` is compared with the Last-Modified date of the response.
+ *
+ * @param etag The ETag of the response, including its quotes, empty if it has none.
+ * @param lastModified The Last-Modified date of the response, empty if it has none.
+ * @return True if the client's copy matches, so the response can be answered with 304 Not Modified.
+ */
+bool Request::isNotModified(std::string_view etag, std::string_view lastModified) const{
+    auto ifNoneMatch = requestHeaders.find("if-none-match");
+    if(ifNoneMatch != requestHeaders.end()){
+        if(etag.empty()) return false;
+        std::string_view tags = ifNoneMatch->second;
+        std::string_view responseTag = opaqueTag(etag);
+        while(!tags.empty()){
+            std::size_t comma = tags.find(',');
+            std::string_view tag = tags.substr(0, comma);
+            tags = (comma == std::string_view::npos) ? std::string_view() : tags.substr(comma + 1);
+
+            std::size_t start = tag.find_first_not_of(" \t");
+            if(start == std::string_view::npos) continue;
+            tag = tag.substr(start, tag.find_last_not_of(" \t") - start + 1);
+            if(tag == "*" || opaqueTag(tag) == responseTag) return true;
+        }
+        return false;
+    }
+
+    const std::string& ifModifiedSince = getRequestHeader("if-modified-since");
+    if(ifModifiedSince.empty() || lastModified.empty()) return false;
+    std::time_t cachedTime, modifiedTime;
+    if(!HttpDate::parse(ifModifiedSince, cachedTime) || !HttpDate::parse(lastModified, modifiedTime)) return false;
+    return modifiedTime <= cachedTime;
+}
+
+/**
+ * @brief Checks whether the `Range` header of the request may be applied to a representation.
+ *
+ * A client resuming a download sends `If-Range` with the validator of the copy it has, so that it
+ * gets the whole representation instead of a part of a different version. An entity tag matches
+ * with the strong comparison of RFC 9110, a weak tag never matches. A date matches only if it is
+ * exactly the Last-Modified date.
+ *
+ * @param etag The ETag of the representation, including its quotes, empty if it has none.
+ * @param lastModified The Last-Modified date of the representation, empty if it has none.
+ * @return True if the request has no `If-Range` header or it matches.
+ */
+bool Request::isRangeCurrent(std::string_view etag, std::string_view lastModified) const{
+    auto ifRange = requestHeaders.find("if-range");
+    if(ifRange == requestHeaders.end()) return true;
+    std::string_view validator = ifRange->second;
+    if(!validator.empty() && validator.front() == '"') return !etag.empty() && etag.front() == '"' && validator == etag;
+    if(validator.size() >= 2 && validator[0] == 'W' && validator[1] == '/') return false;
+
+    std::time_t rangeTime, modifiedTime;
+    if(lastModified.empty() || !HttpDate::parse(validator, rangeTime) || !HttpDate::parse(lastModified, modifiedTime)) return false;
+    return rangeTime == modifiedTime;
+}
+
+/**
+ * @brief Checks whether the client sent `Expect: 100-continue`.
+ *
+ * Such a client waits for an interim `100 Continue` response before it sends the request body.
+ *
+ * @return True if the request carries an `Expect: 100-continue` header.
+ */
+bool Request::expectsContinue() const{
+    std::string expect = getRequestHeader("expect");
+    std::transform(expect.begin(), expect.end(), expect.begin(), [](unsigned char c){ return std::tolower(c); });
+    return expect == "100-continue";
 }
 
 /**
@@ -2,6 +2,10 @@
 #define REQUEST_H
 #include <string>
 #include <unordered_map>
+#include <string_view>
+#include "routeparams.h"
+#include "requestcontext.h"
+#include "contextkey.h"
 
 /**
  * @class Request
@@ -23,16 +27,25 @@ private:
     std::string requestRoute;   ///< The requested route
     std::unordered_map<std::string, std::string> requestBody;   ///< The request body parameters, typically for POST requests.
     std::unordered_map<std::string, std::string> requestQueryParams;      ///< The query parameters from the URL
+    std::unordered_map<std::string, std::string> requestHeaders;   ///< The request headers, keyed by lower-case header name
     std::string contentType;    ///< The content type of the request
+    std::size_t contentLength = 0;  ///< The value of the Content-Length header, 0 if absent, the maximum size_t if it overflows
+    bool contentLengthValid = true; ///< False if the Content-Length header is not a non-negative decimal number
+    std::string rawBody;        ///< The raw body bytes received so far
+    bool bodyReceived = false;  ///< Whether the complete body has been received and parsed
+    RouteParams routeParams;    ///< Parameters captured by the matched route, as views into the interned parameter names and requestRoute
+    RequestContext context;     ///< Values attached by middleware, see setContext
 
     Request(std::string& rawRequest);         // Only WebServer Class can create an instance of the Request class
 
     void parseRequest(std::string& rawRequest);
     void parseQueryParameters(const std::string& queryString);
     void parseRequestBody(const std::string& body);
+    bool expectsContinue() const;
 
 public:
     friend class WebServer;
+    friend class RadixTree;
 
     // Getters
     
@@ -64,6 +77,54 @@ public:
      */
     const std::unordered_map<std::string, std::string>& getRequestQuery() const { return requestQueryParams; }
 
+    /**
+     * @brief Gets the request headers.
+     *
+     * @return An std::unordered_map of type <std::string, std::string> containing the request headers, keyed by lower-case header name.
+     */
+    const std::unordered_map<std::string, std::string>& getRequestHeaders() const { return requestHeaders; }
+
+    const std::string& getRequestHeader(const std::string& headerName) const;
+
+    /**
+     * @brief Gets the parameters captured by the matched route.
+     *
+     * For the route `/users/:id` and the request `/users/42` this contains the pair ("id", "42").
+     * The values are views into the request path and the names into storage the router keeps for
+     * the lifetime of the program, so both stay valid for the lifetime of the request, even if the
+     * routes are changed while it is being handled.
+     *
+     * @return The captured (name, value) pairs in the order they appear in the route.
+     */
+    const RouteParams& getRouteParams() const { return routeParams; }
+
+    std::string_view getRouteParam(std::string_view paramName) const;
+
+    bool isNotModified(std::string_view etag, std::string_view lastModified) const;
+    bool isRangeCurrent(std::string_view etag, std::string_view lastModified) const;
+
+    /**
+     * @brief Attaches a value to the request, for later middleware and the response function.
+     *
+     * The value is constructed in place from the arguments and replaces any previous value for
+     * the key. It is destroyed with the request.
+     *
+     * @param key The key of the value, created once at startup.
+     * @param args The arguments passed to the constructor of T.
+     * @return The attached value.
+     */
+    template <typename T, typename... Args>
+    T& setContext(const ContextKey<T>& key, Args&&... args){ return context.set(key, std::forward<Args>(args)...); }
+
+    /**
+     * @brief Gets a value attached to the request with setContext.
+     *
+     * @param key The key of the value.
+     * @return The value, nullptr if none was attached to this request.
+     */
+    template <typename T>
+    T* getContext(const ContextKey<T>& key) const { return context.get(key); }
+
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include <stdexcept>
+#include <string>
+
+#include "requestcontext.h"
+
+std::atomic<std::size_t> RequestContext::slotCount(0);
+
+/**
+ * @brief Destroys the values of all slots, the last slot first.
+ */
+RequestContext::~RequestContext(){
+    for(std::size_t slot = capacity; slot > 0; slot--){
+        release(slots[slot - 1]);
+    }
+}
+
+/**
+ * @brief Reserves a slot for a new ContextKey.
+ *
+ * Keys are meant to be created once at startup, typically as global variables, not per request.
+ *
+ * @return The index of the slot.
+ * @throw std::runtime_error if all `capacity` slots are taken.
+ */
+std::size_t RequestContext::allocateSlot(){
+    std::size_t slot = slotCount.fetch_add(1);
+    if(slot >= capacity){
+        throw std::runtime_error("Too many ContextKeys, at most " + std::to_string(capacity) + " are supported");
+    }
+    return slot;
+}
+
+/**
+ * @brief Allocates memory for a value from the arena, or from the heap if the arena is full.
+ *
+ * @param size The size of the value.
+ * @param alignment The alignment of the value, at most alignof(std::max_align_t).
+ * @param heapAllocated Set to true if the memory comes from the heap.
+ * @return The memory.
+ */
+void* RequestContext::allocate(std::size_t size, std::size_t alignment, bool &heapAllocated){
+    std::size_t offset = (arenaUsed + alignment - 1) & ~(alignment - 1);
+    if(offset + size <= arenaSize){
+        arenaUsed = offset + size;
+        heapAllocated = false;
+        return arena + offset;
+    }
+    heapAllocated = true;
+    return ::operator new(size);
+}
+
+/**
+ * @brief Destroys the value of a slot, if any. Arena memory is only reclaimed with the request.
+ */
+void RequestContext::release(Slot &slot){
+    if(!slot.value) return;
+    slot.destroy(slot.value);
+    if(slot.heapAllocated) ::operator delete(slot.value);
+    slot.value = nullptr;
+    slot.destroy = nullptr;
+    slot.heapAllocated = false;
+}
@@ -0,0 +1,93 @@
+#ifndef REQUESTCONTEXT_H
+#define REQUESTCONTEXT_H
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+template <typename T>
+class ContextKey;
+
+/**
+ * @brief Typed values attached to a request by middleware, for later middleware and the handler.
+ *
+ * Every value lives in a slot identified by a ContextKey, so reading it is an array access. Values
+ * are constructed in a small arena inside the context, which is part of the Request, so attaching
+ * small values such as a user id or a decoded session does not allocate. Values that do not fit
+ * into the remaining arena are allocated on the heap. All values are destroyed with the request.
+ */
+class RequestContext{
+public:
+    static const std::size_t capacity = 16;    ///< Maximum number of ContextKeys in the program
+    static const std::size_t arenaSize = 256;  ///< Bytes of inline storage for the values of one request
+
+private:
+    struct Slot {
+        void* value = nullptr;
+        void (*destroy)(void* value) = nullptr;
+        bool heapAllocated = false;
+    };
+
+    alignas(std::max_align_t) unsigned char arena[arenaSize];
+    std::size_t arenaUsed = 0;
+    std::array<Slot, capacity> slots;
+
+    static std::atomic<std::size_t> slotCount;
+
+    void* allocate(std::size_t size, std::size_t alignment, bool& heapAllocated);
+    void release(Slot& slot);
+
+    template <typename T>
+    static void destroyValue(void* value){
+        static_cast<T*>(value)->~T();
+    }
+
+public:
+    RequestContext() = default;
+    ~RequestContext();
+    RequestContext(const RequestContext&) = delete;
+    RequestContext& operator=(const RequestContext&) = delete;
+
+    static std::size_t allocateSlot();
+
+    /**
+     * @brief Constructs the value of a slot, replacing the previous value if there is one.
+     *
+     * @param key The slot.
+     * @param args The arguments passed to the constructor of T.
+     * @return The new value.
+     */
+    template <typename T, typename... Args>
+    T& set(const ContextKey<T>& key, Args&&... args){
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types cannot be stored in a RequestContext");
+        Slot& slot = slots[key.getSlot()];
+        release(slot);
+
+        bool heapAllocated;
+        void* memory = allocate(sizeof(T), alignof(T), heapAllocated);
+        try{
+            slot.value = new (memory) T(std::forward<Args>(args)...);
+        }
+        catch(...){
+            if(heapAllocated) ::operator delete(memory);
+            throw;
+        }
+        slot.destroy = &destroyValue<T>;
+        slot.heapAllocated = heapAllocated;
+        return *static_cast<T*>(slot.value);
+    }
+
+    /**
+     * @brief Gets the value of a slot.
+     *
+     * @param key The slot.
+     * @return The value, nullptr if it was not set for this request.
+     */
+    template <typename T>
+    T* get(const ContextKey<T>& key) const {
+        return static_cast<T*>(slots[key.getSlot()].value);
+    }
+};
+
+#endif
@@ -1,203 +1,230 @@
 #include "response.h"
+#include "httpstatus.h"
 #include <iostream>
 #include <string>
 #include <fstream>
 #include <sstream>
 #include <unordered_map>
-#include <vector>
+#include <charconv>
+#include <string_view>
 
 /**
  * @brief Default constructor for the Response class.
  * 
  * Initializes the Response object with default values for HTTP-related fields:
- *   - HTTP version: "HTTP/1.1"
- *   - HTTP status code: "200"
- *   - HTTP status message: "OK"
+ *   - HTTP status code: 200
  *   - HTTP content type: "text/plain"
  *   - HTTP content: ""
- * After initialization, it initializes the map of HTTP status codes to status messages
- * and creates the HTTP response string.
+ * The HTTP response string is only created when it is needed, so constructing a Response
+ * does not allocate.
  */
 Response::Response() 
-    : httpVersion("HTTP/1.1"),
-      httpStatusCode("200"),
-      httpStatus("OK"),
-      httpContentType("text/plain"),
-      httpContent("") 
+    : httpStatusCode(200),
+      httpContentType("text/plain")
 {
-    initHttpStatusCodeMap();
-    createHttpResponse();
 }
 
 /**
- * @brief Initializes the map of HTTP status codes to status messages.
- * 
- * Populates the httpStatusCodes unordered map with key-value pairs,
- * where the keys are HTTP status codes and the values are their corresponding status messages.
- * This map is used to retrieve status messages based on HTTP status codes when creating HTTP responses.
+ * @brief Appends the status line of a status code, taken from the shared table.
+ *
+ * @param output The buffer to append to.
+ * @param statusCode The HTTP status code.
  */
-void Response::initHttpStatusCodeMap(){
-    httpStatusCodes = {
-    {100, "Continue"},
-    {101, "Switching Protocols"},
-    {102, "Processing"},
-    {200, "OK"},
-    {201, "Created"},
-    {202, "Accepted"},
-    {203, "Non-Authoritative Information"},
-    {204, "No Content"},
-    {205, "Reset Content"},
-    {206, "Partial Content"},
-    {207, "Multi-Status"},
-    {208, "Already Reported"},
-    {226, "IM Used"},
-    {300, "Multiple Choices"},
-    {301, "Moved Permanently"},
-    {302, "Found"},
-    {303, "See Other"},
-    {304, "Not Modified"},
-    {305, "Use Proxy"},
-    {307, "Temporary Redirect"},
-    {308, "Permanent Redirect"},
-    {400, "Bad Request"},
-    {401, "Unauthorized"},
-    {402, "Payment Required"},
-    {403, "Forbidden"},
-    {404, "Not Found"},
-    {405, "Method Not Allowed"},
-    {406, "Not Acceptable"},
-    {407, "Proxy Authentication Required"},
-    {408, "Request Timeout"},
-    {409, "Conflict"},
-    {410, "Gone"},
-    {411, "Length Required"},
-    {412, "Precondition Failed"},
-    {413, "Payload Too Large"},
-    {414, "URI Too Long"},
-    {415, "Unsupported Media Type"},
-    {416, "Range Not Satisfiable"},
-    {417, "Expectation Failed"},
-    {421, "Misdirected Request"},
-    {422, "Unprocessable Entity"},
-    {423, "Locked"},
-    {424, "Failed Dependency"},
-    {426, "Upgrade Required"},
-    {428, "Precondition Required"},
-    {429, "Too Many Requests"},
-    {431, "Request Header Fields Too Large"},
-    {451, "Unavailable For Legal Reasons"},
-    {500, "Internal Server Error"},
-    {501, "Not Implemented"},
-    {502, "Bad Gateway"},
-    {503, "Service Unavailable"},
-    {504, "Gateway Timeout"},
-    {505, "HTTP Version Not Supported"},
-    {506, "Variant Also Negotiates"},
-    {507, "Insufficient Storage"},
-    {508, "Loop Detected"},
-    {510, "Not Extended"},
-    {511, "Network Authentication Required"}
-};
+static void appendStatusLine(std::string &output, int statusCode){
+    std::string_view line = httpStatusLine(statusCode);
+    if(!line.empty()){
+        output.append(line.data(), line.size());
+        return;
+    }
+    std::string_view message = httpStatusMessage(statusCode);
+    output.append("HTTP/1.1 ").append(std::to_string(statusCode)).append(" ").append(message.data(), message.size()).append("\r\n");
 }
 
 /**
- * @brief Retrieves the status message for a given HTTP status code.
- * 
- * @param statusCode The HTTP status code for which to retrieve the status message.
- * @return The status message corresponding to the provided HTTP status code.
- * If the status code is not found in the map, returns "Unknown Status Code".
+ * @brief Appends the server's `Date` and `Server` header lines, unless the response sets these headers itself.
+ *
+ * @param output The buffer to append to.
+ * @param dateLine The `Date` header line including its CRLF.
+ * @param serverLine The `Server` header line including its CRLF.
  */
-std::string Response::getStatusMessage(int statusCode) {
-    std::unordered_map<int, std::string>::iterator it = httpStatusCodes.find(statusCode);
-    if (it != httpStatusCodes.end()) {
-        return it->second;
-    } else {
-        return "Unknown Status Code";
+void Response::appendServerHeaders(std::string &output, std::string_view dateLine, std::string_view serverLine) const{
+    if(!dateLine.empty() && httpHeaders.get(HttpHeader::DATE).empty()){
+        output.append(dateLine.data(), dateLine.size());
+    }
+    if(!serverLine.empty() && httpHeaders.get(HttpHeader::SERVER).empty()){
+        output.append(serverLine.data(), serverLine.size());
     }
 }
 
 /**
- * @brief Constructs the complete HTTP response by combining HTTP version, status code,
- * status message, content type, content length, and content.
+ * @brief Serializes the status line and headers of the HTTP response into an output buffer.
+ *
+ * The response is only serialized here, when the server sends it, so setting its fields any
+ * number of times never copies the content. The buffer is grown once to the final size and then
+ * filled, and since the server reuses it for every request, it usually needs no allocation at all.
+ * The headers set with setHeader follow the status line.
+ *
+ * The body is not written: the server sends it after the head in the way that suits its kind, see
+ * ResponseBody. A body of known length gets a `Content-Length` header, a generator of unknown
+ * length is sent with `Transfer-Encoding: chunked`. Responses that cannot have a body (1xx, 204 and 304) get neither,
+ * nor a `Content-Type`.
+ *
+ * The server passes its cached `Date` and `Server` header lines, which follow the status line
+ * unless the response sets these headers itself.
+ *
+ * @param output The buffer the head is appended to, up to and including the empty line.
+ * @param dateLine The `Date` header line including its CRLF, see HttpDate.
+ * @param serverLine The `Server` header line including its CRLF, empty to send none.
  */
-void Response::createHttpResponse(){
-    httpResponse = httpVersion + " " + httpStatusCode + " " + httpStatus + "\r\n" +
-                   "Content-Type: " + httpContentType + "\r\n" +
-                   "Content-Length: " + std::to_string(httpContent.size()) + "\r\n" +
-                   "\r\n" + httpContent;
+void Response::writeHttpHead(std::string &output, std::string_view dateLine, std::string_view serverLine) const{
+    std::size_t serverHeadersSize = dateLine.size() + serverLine.size();
+    if(!redirectURL.empty()){
+        output.reserve(output.size() + 64 + serverHeadersSize + httpHeaders.serializedSize() + redirectURL.size());
+        appendStatusLine(output, httpStatusCode);
+        appendServerHeaders(output, dateLine, serverLine);
+        httpHeaders.writeTo(output);
+        output.append("Location: ").append(redirectURL).append("\r\nContent-Length: 0\r\n\r\n");
+        return;
+    }
+
+    output.reserve(output.size() + 96 + serverHeadersSize + httpHeaders.serializedSize() + httpContentType.size());
+    appendStatusLine(output, httpStatusCode);
+    appendServerHeaders(output, dateLine, serverLine);
+    httpHeaders.writeTo(output);
+    if(!hasBody()){
+        output.append("\r\n");
+        return;
+    }
+    output.append("Content-Type: ").append(httpContentType).append("\r\n");
+    if(!httpBody.hasLength()){
+        output.append("Transfer-Encoding: chunked\r\n\r\n");
+        return;
+    }
+    char contentLength[24];
+    std::to_chars_result lengthEnd = std::to_chars(contentLength, contentLength + sizeof(contentLength), httpBody.getLength());
+    output.append("Content-Length: ").append(contentLength, lengthEnd.ptr - contentLength).append("\r\n\r\n");
 }
 
 /**
- * @brief Retrieves the constructed HTTP response.
- * @return The constructed HTTP response as a string.
+ * @brief Checks whether the status code allows a body.
+ *
+ * Responses with a 1xx, 204 or 304 status end with their headers, any content set on them is not sent.
+ *
+ * @return False for 1xx, 204 and 304 responses.
  */
-std::string Response::getHttpResponse(){
-    return httpResponse;
+bool Response::hasBody() const{
+    return httpStatusCode >= 200 && httpStatusCode != 204 && httpStatusCode != 304;
 }
 
 /**
- * @brief Sets the content of the HTTP response and updates the response accordingly.
+ * @brief Sets the content of the HTTP response.
  * @param httpContent The content to be set for the HTTP response.
  */
 void Response::setContent(const std::string &httpContent){
-    this->httpContent = httpContent;
-    createHttpResponse();
+    httpBody.getString() = httpContent;
+}
+
+/**
+ * @brief Sets the content of the HTTP response, taking over the string without copying it.
+ * @param httpContent The content to be set for the HTTP response.
+ */
+void Response::setContent(std::string &&httpContent){
+    httpBody.setString(std::move(httpContent));
+}
+
+/**
+ * @brief Sets content that is shared with other responses, e.g. a page rendered once and cached.
+ *
+ * The buffer is sent directly from where it is, together with the headers in one gathered write,
+ * and is never copied.
+ *
+ * @param sharedContent The content. It must not be modified while it is shared.
+ */
+void Response::setContent(std::shared_ptr<const std::string> sharedContent){
+    httpBody.setSharedBuffer(std::move(sharedContent));
 }
 
 /**
- * @brief Sets the HTTP status code and status message, then updates the response.
+ * @brief Sets a region of an open file as the content.
+ *
+ * The file is sent by the operating system with TransmitFile, it is never read into memory.
+ *
+ * @param fileRegion The region, e.g. from FileRegion::open.
+ */
+void Response::setFileContent(const FileRegion &fileRegion){
+    httpBody.setFileRegion(fileRegion);
+}
+
+/**
+ * @brief Sets a generator that produces the content while the response is sent.
+ *
+ * The response is sent with `Transfer-Encoding: chunked`, one chunk per call of the generator, so
+ * the content never has to be held in memory at once.
+ *
+ * @param contentGenerator The generator, see BodyGenerator.
+ */
+void Response::setContentGenerator(BodyGenerator contentGenerator){
+    httpBody.setGenerator(std::move(contentGenerator));
+}
+
+/**
+ * @brief Sets the HTTP status code.
  * @param httpStatusCode The status code to be set for the HTTP response.
  */
 void Response::setStatusCode(const int &httpStatusCode){
-    this->httpStatusCode = std::to_string(httpStatusCode);
-    this->httpStatus = getStatusMessage(httpStatusCode);
-    createHttpResponse();
+    this->httpStatusCode = httpStatusCode;
 }
 
 /**
- * @brief Sets the content type of the HTTP response and updates the response accordingly.
+ * @brief Sets the content type of the HTTP response.
  * @param httpContentType The content type to be set for the HTTP response.
  */
 void Response::setContentType(const std::string &httpContentType){
     this->httpContentType = httpContentType;
-    createHttpResponse();
 }
 
 /**
- * @brief Reads the content from an HTML file, sets it as the HTTP response content, and updates the response.
- * @param relativeFilePath The relative path of the HTML file to be read and served as the HTTP response content.
+ * @brief Sets a response header, replacing any header with the same name.
+ *
+ * Setting `Content-Type` is the same as calling setContentType. `Content-Length` is always
+ * computed from the content and cannot be set. CR and LF in the name or value are replaced by
+ * spaces.
+ *
+ * @param name The header name, e.g. HttpHeader::CACHE_CONTROL or "X-Request-Id". Case is ignored.
+ * @param value The header value.
  */
-void Response::render_template(const std::string &relativeFilePath){
-    readHTMLFile(relativeFilePath);
-    createHttpResponse();
+void Response::setHeader(std::string_view name, std::string_view value){
+    if(HttpHeader::equals(name, HttpHeader::CONTENT_TYPE)){
+        httpContentType.assign(value.data(), value.size());
+        return;
+    }
+    if(HttpHeader::equals(name, HttpHeader::CONTENT_LENGTH)) return;
+    httpHeaders.set(name, value);
 }
 
 /**
- * @brief Reads the content from an HTML file, sets it as the HTTP response content, and updates the response.
- * @param relativeFilePath The relative path of the HTML file to be read and served as the HTTP response content.
+ * @brief Adds a response header, keeping headers with the same name, e.g. several `Set-Cookie` headers.
+ *
+ * @param name The header name.
+ * @param value The header value.
  */
-void Response::readHTMLFile(const std::string &relativeFilePath){
-    // Construct the full file path by appending the relative file path to the templates directory
-    std::string fullFilePath = "./templates/"+relativeFilePath;
-    
-    // Attempt to open the file
-    std::ifstream fileStream(fullFilePath);
-
-     // If the file cannot be opened, set an error response and return
-    if (!fileStream) {
-        std::cerr << "File not found: " << fullFilePath << std::endl;
-        httpContent = "File not found";
-        httpStatusCode = "404";
-        httpStatus = "Not Found";
-        httpContentType = "text/plain";
-        createHttpResponse();
+void Response::addHeader(std::string_view name, std::string_view value){
+    if(HttpHeader::equals(name, HttpHeader::CONTENT_TYPE) || HttpHeader::equals(name, HttpHeader::CONTENT_LENGTH)){
+        setHeader(name, value);
         return;
     }
-    std::stringstream buffer;
-    buffer << fileStream.rdbuf();
-    httpContent = buffer.str();
-    httpContentType = "text/html";
-    createHttpResponse();
+    httpHeaders.add(name, value);
+}
+
+/**
+ * @brief Gets the value of a response header.
+ *
+ * @param name The header name.
+ * @return The value, an empty view if the header is not set.
+ */
+std::string_view Response::getHeader(std::string_view name) const{
+    if(HttpHeader::equals(name, HttpHeader::CONTENT_TYPE)) return httpContentType;
+    return httpHeaders.get(name);
 }
 
 /**
@@ -218,21 +245,6 @@ std::string Response::readFile(const std::string &filePath)
     return contents.str();
 }
 
-/**
- * @brief Reads the contents of a binary file and returns it as a vector of characters.
- * 
- * @param filePath The path to the binary file to be read.
- * @return std::vector<char> The contents of the binary file as a vector of characters.
- * @throw std::runtime_error if the file cannot be opened.
- */
-std::vector<char> readFileBinary(const std::string& filePath) {
-    std::ifstream file(filePath, std::ios::binary);
-    if (!file) {
-        throw std::runtime_error("Failed to open file: " + filePath);
-    }
-    return std::vector<char>(std::istreambuf_iterator<char>(file), {});
-}
-
 /**
  * @brief Determines the MIME type of a file based on its extension.
  * 
@@ -265,48 +277,15 @@ std::string Response::getMimeType(const std::string &filePath){
 }
 
 /**
- * @brief Serves a file to be included in an HTTP response.
- * 
- * @param filePath The path to the file to be served.
- * @param directory The directory where the file is located.
- * 
- * This method attempts to read the specified file from the given directory,
- * extract its content, determine its MIME type, and create an HTTP response
- * with the file's content and appropriate headers.
- * 
- * If the file is successfully read, it sets the HTTP status code to "200 OK"
- * and the MIME type based on the file's extension. If the file is not found
- * or cannot be read, it sets the HTTP status code to "404 Not Found" and
- * returns a plain text response indicating that the file was not found.
+ * @brief Turns the response into a header-only `304 Not Modified`.
+ *
+ * The body is dropped, the validators and other headers are kept, as the client updates its
+ * cached copy with them.
  */
-void Response::serveFile(const std::string &filePath, const std::string &directory){
-    try {
-        std::string fullPath = "."+ directory + filePath;
-        std::vector<char> fileContent = readFileBinary(fullPath);
-        std::string mimeType = getMimeType(fullPath);
-
-        httpContentType = mimeType;
-        httpContent.assign(fileContent.begin(), fileContent.end());
-        httpStatusCode = "200";
-        httpStatus = "OK";
-        createHttpResponse();
-    } catch (const std::exception& e) {
-        httpStatusCode = "404";
-        httpStatus = "Not Found";
-        httpContentType = "text/plain";
-        httpContent = "File not found";
-        createHttpResponse();
-    }
-}
-
-bool Response::operator==(const Response &other) const{
-    if(this->httpContent == other.httpContent) return true;
-    return false;
-}
-
-bool Response::operator!=(const Response &other) const{
-    if(this->httpContent != other.httpContent) return true;
-    return false;
+void Response::setNotModified(){
+    httpStatusCode = 304;
+    httpBody.setString(std::string());
+    httpHeaders.remove(HttpHeader::CONTENT_ENCODING);
 }
 
 /**
@@ -316,10 +295,6 @@ bool Response::operator!=(const Response &other) const{
  * @param statusCode The HTTP status code for the redirect. Default is 302 (Found).
  */
 void Response::redirect(std::string redirectURL, int statusCode) {
-    httpStatusCode = std::to_string(statusCode);
-    httpStatus = getStatusMessage(statusCode);
-    httpResponse = httpVersion + " " + httpStatusCode + " " + httpStatus + "\r\n" +
-                   "Location: " + redirectURL + "\r\n" +
-                   "Content-Length: 0\r\n" + 
-                   "\r\n";
+    httpStatusCode = statusCode;
+    this->redirectURL = std::move(redirectURL);
 }
\ No newline at end of file
@@ -4,53 +4,71 @@
 #include <string>
 #include <fstream>
 #include <unordered_map>
+#include <string_view>
+#include "httpheader.h"
+#include "responseheaders.h"
+#include "responsebody.h"
+#include "contentencoding.h"
+
+class Request;
 
 /**
  * @brief The Response class represents an HTTP response.
  * 
  * This class encapsulates the components of an HTTP response, such as the HTTP version,
  * status code, content type, and content. It provides methods to set and retrieve these
- * components, as well as methods to generate an HTTP response string.
+ * components. The server serializes the response when it sends it.
+ *
+ * The content is a ResponseBody: a string, a shared buffer, a region of a file or a generator.
+ *
+ * Static files and templates carry an `ETag` and a `Last-Modified` header, taken from the
+ * ValidatorCache, so that a client revalidating its cached copy is answered with a header-only
+ * `304 Not Modified`. Files served for a request also honour its `Range` header, see serveFile.
+ * The functions that read files are defined in responsefile.cpp, apart from the rest of the class.
  */
 class Response{
 private:
-    std::string httpResponse;   /**< The generated HTTP response string. */
-    std::string httpVersion;    /**< The HTTP version (e.g., "HTTP/1.1"). */
-    std::string httpStatusCode; /**< The HTTP status code (e.g., "200"). */
-    std::string httpStatus; /**< The HTTP status message (e.g., "OK"). */
+    int httpStatusCode; /**< The HTTP status code (e.g., 200), its status line comes from the shared table in httpstatus.h. */
     std::string httpContentType; /**< The content type of the HTTP response. */
-    std::string httpContent; /**< The content of the HTTP response. */
-
-    std::unordered_map<int, std::string> httpStatusCodes; /**< Map of HTTP status codes to status messages. */
-    void initHttpStatusCodeMap();
-    std::string getStatusMessage(int statusCode);
+    ResponseBody httpBody; /**< The content of the HTTP response. */
+    std::string redirectURL; /**< The Location of a redirect, empty for other responses. */
+    ResponseHeaders httpHeaders; /**< Headers other than Content-Type and Content-Length. */
 
-    void createHttpResponse();
-
-    std::string getHttpResponse();
+    void appendServerHeaders(std::string& output, std::string_view dateLine, std::string_view serverLine) const;
+    void writeHttpHead(std::string& output, std::string_view dateLine = {}, std::string_view serverLine = {}) const;
+    bool hasBody() const;
+    bool setByteRanges(const Request& request, const FileRegion& fileRegion);
 
     void readHTMLFile(const std::string &relativeFilePath);
 
     std::string readFile(const std::string& filePath);
     std::string getMimeType(const std::string& filePath);
 
-    bool operator==(const Response& other) const;
-    bool operator!=(const Response& other) const;
-
 
 public:
     Response();
 
     void setContent(const std::string& httpContent);
+    void setContent(std::string&& httpContent);
+    void setContent(std::shared_ptr<const std::string> sharedContent);
+    void setFileContent(const FileRegion& fileRegion);
+    void setContentGenerator(BodyGenerator contentGenerator);
     void setStatusCode(const int& httpStatusCode);
     void setContentType(const std::string& httpContentType);
+    void setHeader(std::string_view name, std::string_view value);
+    void addHeader(std::string_view name, std::string_view value);
+    std::string_view getHeader(std::string_view name) const;
     void render_template(const std::string& relativeFilePath);
     void serveFile(const std::string& filePath, const std::string& directory);
+    void serveFile(const std::string& filePath, const std::string& directory, const Request& request, bool precompressed = false);
+    void setNotModified();
     void redirect(std::string redirectURL, int statusCode=302);
 
-    friend class Middleware;
-    friend class AVLTree;
+    friend class RadixTree;
     friend class WebServer;
+    friend class ResponseCompressor;
+    friend class StaticMount;
+    friend class JsonWriter;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "responsebody.h"
+
+/**
+ * @brief Gets the length of the body in bytes.
+ *
+ * @return The length, 0 for a generator whose length is only known once it is exhausted.
+ */
+std::uint64_t ResponseBody::getLength() const{
+    switch(getKind()){
+        case FILE_REGION:
+            return getFileRegion().getLength();
+        case GENERATOR:
+            return generatorLength.value_or(0);
+        default:
+            return getData().size();
+    }
+}
+
+/**
+ * @brief Gets the bytes of an in-memory body.
+ *
+ * @return The string or shared buffer, an empty view for a file region or a generator, or for a null shared buffer.
+ */
+std::string_view ResponseBody::getData() const{
+    if(const std::string* text = std::get_if<STRING>(&content)) return *text;
+    if(const std::shared_ptr<const std::string>* buffer = std::get_if<SHARED_BUFFER>(&content)){
+        if(*buffer) return **buffer;
+    }
+    return {};
+}
+
+/**
+ * @brief Gets the owned string of the body, e.g. to read a file into it.
+ *
+ * @return The string. A body of any other kind is replaced by an empty string first.
+ */
+std::string& ResponseBody::getString(){
+    if(getKind() != STRING) content.emplace<STRING>();
+    return std::get<STRING>(content);
+}
+
+/**
+ * @brief Replaces the body with an owned string.
+ *
+ * @param text The content.
+ */
+void ResponseBody::setString(std::string text){
+    content.emplace<STRING>(std::move(text));
+}
+
+/**
+ * @brief Replaces the body with a shared buffer, which is sent without being copied.
+ *
+ * @param buffer The buffer. It must not be modified while responses that share it are sent.
+ */
+void ResponseBody::setSharedBuffer(std::shared_ptr<const std::string> buffer){
+    content.emplace<SHARED_BUFFER>(std::move(buffer));
+}
+
+/**
+ * @brief Replaces the body with a region of an open file.
+ *
+ * @param region The region.
+ */
+void ResponseBody::setFileRegion(FileRegion region){
+    content.emplace<FILE_REGION>(std::move(region));
+}
+
+/**
+ * @brief Replaces the body with a generator. It is held by a shared pointer, so that a Response stays copyable.
+ *
+ * @param generator The generator.
+ */
+void ResponseBody::setGenerator(BodyGenerator generator){
+    content.emplace<GENERATOR>(std::make_shared<BodyGenerator>(std::move(generator)));
+    generatorLength.reset();
+}
+
+/**
+ * @brief Replaces the body with a generator whose output has a known length, which is sent with a
+ * `Content-Length` instead of chunked.
+ *
+ * @param generator The generator. It must produce exactly `length` bytes.
+ * @param length The length of the body.
+ */
+void ResponseBody::setGenerator(BodyGenerator generator, std::uint64_t length){
+    content.emplace<GENERATOR>(std::make_shared<BodyGenerator>(std::move(generator)));
+    generatorLength = length;
+}
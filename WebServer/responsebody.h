@@ -0,0 +1,51 @@
+#ifndef RESPONSEBODY_H
+#define RESPONSEBODY_H
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include "fileregion.h"
+#include "bodygenerator.h"
+
+/**
+ * @brief The body of a Response, in whichever form it was produced.
+ *
+ * A body is one of:
+ *   - STRING: an owned string, the content set with Response::setContent.
+ *   - SHARED_BUFFER: a reference-counted string that many responses can send without copying it,
+ *     e.g. a cached page.
+ *   - FILE_REGION: a byte range of an open file, which the server sends with TransmitFile.
+ *   - GENERATOR: a BodyGenerator that is pulled until it is exhausted, sent chunked unless its
+ *     length is known in advance.
+ *
+ * The server picks the cheapest way to send each form, see WebServer::sendResponse.
+ */
+class ResponseBody{
+public:
+    enum Kind { STRING, SHARED_BUFFER, FILE_REGION, GENERATOR };
+
+private:
+    // The alternatives are in the order of Kind
+    std::variant<std::string, std::shared_ptr<const std::string>, FileRegion, std::shared_ptr<BodyGenerator>> content;
+    std::optional<std::uint64_t> generatorLength;   ///< The length of a generated body, if known in advance
+
+public:
+    Kind getKind() const { return static_cast<Kind>(content.index()); }
+
+    bool hasLength() const { return getKind() != GENERATOR || generatorLength.has_value(); }
+    std::uint64_t getLength() const;
+    std::string_view getData() const;
+    const FileRegion& getFileRegion() const { return std::get<FILE_REGION>(content); }
+    BodyGenerator& getGenerator() const { return *std::get<GENERATOR>(content); }
+
+    std::string& getString();
+    void setString(std::string text);
+    void setSharedBuffer(std::shared_ptr<const std::string> buffer);
+    void setFileRegion(FileRegion region);
+    void setGenerator(BodyGenerator generator);
+    void setGenerator(BodyGenerator generator, std::uint64_t length);
+};
+
+#endif
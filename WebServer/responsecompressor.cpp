@@ -0,0 +1,303 @@
+#include "responsecompressor.h"
+#include "httpheader.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+#ifdef WEBSERVER_WITH_BROTLI
+static const int brotliQuality = 5;     ///< Quality 11 is far too slow to compress while sending, 5 still beats gzip
+#endif
+
+/**
+ * @brief Releases the encoder state.
+ */
+ResponseCompressor::~ResponseCompressor(){
+#ifdef WEBSERVER_WITH_ZLIB
+    if(gzipInitialized) deflateEnd(&gzipStream);
+    if(deflateInitialized) deflateEnd(&deflateStream);
+#endif
+#ifdef WEBSERVER_WITH_BROTLI
+    if(brotliState) BrotliEncoderDestroyInstance(brotliState);
+#endif
+}
+
+/**
+ * @brief The encodings that were compiled in, indexed by ContentEncoding.
+ */
+static const bool compiledEncodings[ENCODING_COUNT] = {
+    false,
+#ifdef WEBSERVER_WITH_ZLIB
+    true, true,
+#else
+    false, false,
+#endif
+#ifdef WEBSERVER_WITH_BROTLI
+    true
+#else
+    false
+#endif
+};
+
+/**
+ * @brief Checks whether content of a type is worth compressing.
+ *
+ * @param contentType The content type, parameters such as charset are ignored.
+ * @return False for types whose content is already compressed, e.g. image/png, image/jpeg, video or archives.
+ */
+bool ResponseCompressor::isCompressible(std::string_view contentType){
+    static const std::string_view compressedTypes[] = {
+        "image/png", "image/jpeg", "image/gif", "image/webp", "image/avif",
+        "application/zip", "application/gzip", "application/x-gzip", "application/pdf",
+        "application/octet-stream", "font/woff", "font/woff2"
+    };
+    static const std::string_view compressedTypePrefixes[] = { "audio/", "video/" };
+
+    contentType = contentType.substr(0, contentType.find(';'));
+    while(!contentType.empty() && (contentType.back() == ' ' || contentType.back() == '\t')) contentType.remove_suffix(1);
+    for(std::string_view compressedType : compressedTypes){
+        if(HttpHeader::equals(contentType, compressedType)) return false;
+    }
+    for(std::string_view prefix : compressedTypePrefixes){
+        if(contentType.size() >= prefix.size() && HttpHeader::equals(contentType.substr(0, prefix.size()), prefix)) return false;
+    }
+    return true;
+}
+
+#ifdef WEBSERVER_WITH_ZLIB
+/**
+ * @brief Prepares a zlib stream for a new response, initializing it only the first time.
+ *
+ * @param stream The stream.
+ * @param initialized Whether deflateInit2 already ran for the stream, set once it did.
+ * @param windowBits 15 for the zlib wrapper of the deflate coding, 15 + 16 for the gzip wrapper.
+ * @return False if zlib failed.
+ */
+static bool resetZlibStream(z_stream &stream, bool &initialized, int windowBits){
+    if(initialized) return deflateReset(&stream) == Z_OK;
+    std::memset(&stream, 0, sizeof(stream));
+    if(deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) return false;
+    initialized = true;
+    return true;
+}
+#endif
+
+/**
+ * @brief Begins a new compressed stream, abandoning the previous one if it was not finished.
+ *
+ * @param encoding The encoding of the stream.
+ * @return False if the encoder could not be prepared.
+ */
+bool ResponseCompressor::begin(ContentEncoding encoding){
+    activeEncoding = encoding;
+    streamNumber++;
+    source.reset();
+    pendingInput = nullptr;
+    pendingInputLength = 0;
+    sourceExhausted = false;
+    streamFinished = false;
+
+    switch(encoding){
+#ifdef WEBSERVER_WITH_ZLIB
+        case ENCODING_GZIP:
+            return resetZlibStream(gzipStream, gzipInitialized, 15 + 16);
+        case ENCODING_DEFLATE:
+            return resetZlibStream(deflateStream, deflateInitialized, 15);
+#endif
+#ifdef WEBSERVER_WITH_BROTLI
+        case ENCODING_BROTLI:
+            if(brotliState) BrotliEncoderDestroyInstance(brotliState);
+            brotliState = BrotliEncoderCreateInstance(nullptr, nullptr, nullptr);
+            if(!brotliState) return false;
+            BrotliEncoderSetParameter(brotliState, BROTLI_PARAM_QUALITY, brotliQuality);
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Runs the encoder of the active stream once.
+ *
+ * Consumes as much input and fills as much output as the encoder can in one call. Sets
+ * streamFinished once the encoder wrote the end of the stream.
+ *
+ * @param input The input, advanced past the consumed bytes.
+ * @param inputLength The number of input bytes, decreased by the consumed bytes.
+ * @param output The output buffer, advanced past the written bytes.
+ * @param outputCapacity The space in the output buffer, decreased by the written bytes.
+ * @param finish True if the input is the last of the body.
+ * @return False if the encoder failed.
+ */
+bool ResponseCompressor::step([[maybe_unused]] const char *&input, [[maybe_unused]] std::size_t &inputLength, [[maybe_unused]] char *&output,
+                              [[maybe_unused]] std::size_t &outputCapacity, [[maybe_unused]] bool finish){
+    switch(activeEncoding){
+#ifdef WEBSERVER_WITH_ZLIB
+        case ENCODING_GZIP:
+        case ENCODING_DEFLATE: {
+            z_stream& stream = activeEncoding == ENCODING_GZIP ? gzipStream : deflateStream;
+            const std::size_t maximumLength = 1u << 30;       // zlib counts in uInt
+            uInt availableInput = static_cast<uInt>(std::min(inputLength, maximumLength));
+            uInt availableOutput = static_cast<uInt>(std::min(outputCapacity, maximumLength));
+            stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input));
+            stream.avail_in = availableInput;
+            stream.next_out = reinterpret_cast<Bytef*>(output);
+            stream.avail_out = availableOutput;
+            int result = deflate(&stream, finish && availableInput == inputLength ? Z_FINISH : Z_NO_FLUSH);
+            if(result == Z_STREAM_END) streamFinished = true;
+            else if(result != Z_OK && result != Z_BUF_ERROR) return false;
+
+            input += availableInput - stream.avail_in;
+            inputLength -= availableInput - stream.avail_in;
+            output += availableOutput - stream.avail_out;
+            outputCapacity -= availableOutput - stream.avail_out;
+            return true;
+        }
+#endif
+#ifdef WEBSERVER_WITH_BROTLI
+        case ENCODING_BROTLI: {
+            const std::uint8_t* nextInput = reinterpret_cast<const std::uint8_t*>(input);
+            std::uint8_t* nextOutput = reinterpret_cast<std::uint8_t*>(output);
+            if(!BrotliEncoderCompressStream(brotliState, finish ? BROTLI_OPERATION_FINISH : BROTLI_OPERATION_PROCESS,
+                                            &inputLength, &nextInput, &outputCapacity, &nextOutput, nullptr)){
+                return false;
+            }
+            if(BrotliEncoderIsFinished(brotliState)) streamFinished = true;
+            input = reinterpret_cast<const char*>(nextInput);
+            output = reinterpret_cast<char*>(nextOutput);
+            return true;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Compresses an in-memory body at once with the active stream.
+ *
+ * @param data The body.
+ * @return The compressed body, empty if the encoder failed.
+ */
+std::string ResponseCompressor::compressBuffer(std::string_view data){
+    std::string compressed(data.size() / 3 + 64, '\0');
+    const char* input = data.data();
+    std::size_t inputLength = data.size();
+    std::size_t written = 0;
+    while(!streamFinished){
+        if(written == compressed.size()) compressed.resize(compressed.size() * 2);
+        char* output = &compressed[written];
+        std::size_t outputCapacity = compressed.size() - written;
+        if(!step(input, inputLength, output, outputCapacity, true)) return std::string();
+        written = compressed.size() - outputCapacity;
+    }
+    compressed.resize(written);
+    return compressed;
+}
+
+/**
+ * @brief Produces the next piece of a compressed streamed body, the BodyGenerator of a compressed response.
+ *
+ * Reads the original body in chunks of inputChunkSize into the reused input buffer and feeds them
+ * to the encoder until the output buffer is full or the stream is finished. A generator whose
+ * stream was ended by the next call to compress() writes nothing, its body ends there.
+ *
+ * @param stream The streamNumber of the stream the generator was created for.
+ * @param output The buffer to fill.
+ * @param capacity The size of the buffer.
+ * @return The number of bytes written, 0 once the compressed stream is complete.
+ */
+std::size_t ResponseCompressor::pull(std::uint64_t stream, char *output, std::size_t capacity){
+    if(stream != streamNumber){
+        std::cerr << "Compressed response body sent after the next response was compressed, the body is truncated" << std::endl;
+        return 0;
+    }
+    std::size_t remaining = capacity;
+    while(remaining > 0 && !streamFinished){
+        if(pendingInputLength == 0 && !sourceExhausted){
+            inputBuffer.resize(inputChunkSize);
+            std::size_t bytesRead = std::min((*source)(&inputBuffer[0], inputChunkSize), inputChunkSize);
+            if(bytesRead == 0) sourceExhausted = true;
+            pendingInput = inputBuffer.data();
+            pendingInputLength = bytesRead;
+        }
+        if(!step(pendingInput, pendingInputLength, output, remaining, sourceExhausted)){
+            std::cerr << "Compression failed, the " << contentEncodingName(activeEncoding) << " response body is truncated" << std::endl;
+            streamFinished = true;
+        }
+    }
+    if(streamFinished && remaining == capacity) source.reset();
+    return capacity - remaining;
+}
+
+/**
+ * @brief Adds `Accept-Encoding` to the `Vary` header of a response, since its encoding depends on it.
+ *
+ * @param response The response.
+ */
+static void addVaryAcceptEncoding(Response &response){
+    std::string_view vary = response.getHeader(HttpHeader::VARY);
+    if(vary.empty()){
+        response.setHeader(HttpHeader::VARY, "Accept-Encoding");
+        return;
+    }
+    std::string lowercaseVary(vary);
+    std::transform(lowercaseVary.begin(), lowercaseVary.end(), lowercaseVary.begin(), [](unsigned char c){ return std::tolower(c); });
+    if(lowercaseVary.find("accept-encoding") != std::string::npos || lowercaseVary.find('*') != std::string::npos) return;
+    response.setHeader(HttpHeader::VARY, std::string(vary) + ", Accept-Encoding");
+}
+
+/**
+ * @brief Compresses the body of a response if the client accepts a compiled-in encoding.
+ *
+ * Sets `Content-Encoding` and adds `Accept-Encoding` to `Vary`. A strong `ETag` is made weak, since
+ * the compressed bytes differ from those it was computed for. A string or shared buffer is
+ * replaced by its compressed form, unless that is not smaller. A file region or generator is
+ * replaced by a generator that compresses it while it is sent, the response is then sent chunked.
+ * That generator uses this compressor, so it must be sent before the next response is compressed;
+ * sent later, it ends at once.
+ *
+ * @param request The request, whose `Accept-Encoding` header is used.
+ * @param response The response.
+ */
+void ResponseCompressor::compress(const Request &request, Response &response){
+    if(!response.hasBody() || response.httpStatusCode == 206) return;
+    if(!response.redirectURL.empty()) return;
+    if(!response.getHeader(HttpHeader::CONTENT_ENCODING).empty()) return;
+    if(!isCompressible(response.httpContentType)) return;
+    ResponseBody& body = response.httpBody;
+    if(body.hasLength() && body.getLength() < minimumSize) return;
+
+    addVaryAcceptEncoding(response);
+    ContentEncoding encoding = negotiateContentEncoding(request.getRequestHeader("accept-encoding"), compiledEncodings);
+    if(encoding == ENCODING_IDENTITY || !begin(encoding)) return;
+
+    switch(body.getKind()){
+        case ResponseBody::FILE_REGION: {
+            FileRegion fileRegion = body.getFileRegion();
+            source = std::make_shared<BodyGenerator>([fileRegion, position = std::uint64_t(0)](char* buffer, std::size_t capacity) mutable {
+                std::size_t bytesRead = fileRegion.read(position, buffer, capacity);
+                position += bytesRead;
+                return bytesRead;
+            });
+            body.setGenerator([this, stream = streamNumber](char* output, std::size_t capacity){ return pull(stream, output, capacity); });
+            break;
+        }
+        case ResponseBody::GENERATOR:
+            source = std::make_shared<BodyGenerator>(std::move(body.getGenerator()));
+            body.setGenerator([this, stream = streamNumber](char* output, std::size_t capacity){ return pull(stream, output, capacity); });
+            break;
+        default: {
+            std::string_view data = body.getData();
+            std::string compressed = compressBuffer(data);
+            if(compressed.empty() || compressed.size() >= data.size()) return;
+            body.setString(std::move(compressed));
+            break;
+        }
+    }
+    response.setHeader(HttpHeader::CONTENT_ENCODING, contentEncodingName(encoding));
+    std::string_view etag = response.getHeader(HttpHeader::ETAG);
+    if(!etag.empty() && etag[0] == '"') response.setHeader(HttpHeader::ETAG, "W/" + std::string(etag));
+}
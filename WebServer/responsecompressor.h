@@ -0,0 +1,83 @@
+#ifndef RESPONSECOMPRESSOR_H
+#define RESPONSECOMPRESSOR_H
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "request.h"
+#include "response.h"
+#include "bodygenerator.h"
+#include "contentencoding.h"
+
+#ifdef WEBSERVER_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef WEBSERVER_WITH_BROTLI
+#include <brotli/encode.h>
+#endif
+
+/**
+ * @brief Compresses response bodies with the content coding the client accepts.
+ *
+ * The encodings are compiled in with `-DWEBSERVER_WITH_ZLIB` (gzip and deflate, link with `-lz`)
+ * and `-DWEBSERVER_WITH_BROTLI` (br, link with `-lbrotlienc`). Without either, compress() leaves
+ * every response unchanged.
+ *
+ * A response is compressed if the client accepts one of the compiled-in encodings in its
+ * `Accept-Encoding` header, its content type is not already compressed (e.g. image/png or
+ * image/jpeg), its body is at least minimumSize bytes and it has no `Content-Encoding` yet. Partial
+ * content (206) is never compressed, its `Content-Range` refers to the uncompressed bytes.
+ * In-memory bodies are compressed at once, files and generators are compressed while they are
+ * sent, one chunk at a time, so they never have to be held in memory.
+ *
+ * Each server owns one compressor and compresses one response at a time with it. The zlib streams
+ * are initialized once and reset for every response, so no `deflateInit` runs per response. A
+ * streamed body therefore shares the compressor's encoder state: it must be sent before the next
+ * call to compress(), which ends it. A body that is sent later anyway ends early instead of
+ * interleaving its output with that of the next response.
+ */
+class ResponseCompressor{
+public:
+    static constexpr std::size_t minimumSize = 1024;       ///< Smaller bodies gain too little to be worth compressing
+    static constexpr std::size_t inputChunkSize = 16 * 1024;    ///< The bytes read from a streamed body per step
+
+private:
+#ifdef WEBSERVER_WITH_ZLIB
+    z_stream gzipStream;            ///< Initialized on first use with the gzip wrapper, reset for every response
+    z_stream deflateStream;         ///< Initialized on first use with the zlib wrapper, reset for every response
+    bool gzipInitialized = false;
+    bool deflateInitialized = false;
+#endif
+#ifdef WEBSERVER_WITH_BROTLI
+    BrotliEncoderState* brotliState = nullptr;     ///< The encoder has no reset, it is created for every response
+#endif
+
+    ContentEncoding activeEncoding = ENCODING_IDENTITY;     ///< The encoding of the stream begun last
+    std::uint64_t streamNumber = 0;         ///< Counts the streams begun, a generator only pulls from the stream it was created for
+    std::shared_ptr<BodyGenerator> source;  ///< The body being compressed while it is sent
+    std::string inputBuffer;                ///< The buffer source fills, reused for every response
+    const char* pendingInput = nullptr;     ///< Input not yet consumed by the encoder
+    std::size_t pendingInputLength = 0;
+    bool sourceExhausted = false;
+    bool streamFinished = false;
+
+    bool begin(ContentEncoding encoding);
+    bool step(const char*& input, std::size_t& inputLength, char*& output, std::size_t& outputCapacity, bool finish);
+    std::string compressBuffer(std::string_view data);
+    std::size_t pull(std::uint64_t stream, char* output, std::size_t capacity);
+
+public:
+    ResponseCompressor() = default;
+    ~ResponseCompressor();
+
+    ResponseCompressor(const ResponseCompressor&) = delete;
+    ResponseCompressor& operator=(const ResponseCompressor&) = delete;
+
+    // A streamed body it compresses must be sent before the next call, see the class description
+    void compress(const Request& request, Response& response);
+
+    static bool isCompressible(std::string_view contentType);
+};
+
+#endif
@@ -0,0 +1,230 @@
+#include "response.h"
+#include "request.h"
+#include "validatorcache.h"
+#include "byterange.h"
+#include "contentencoding.h"
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// The Response functions that read files, with FileRegion and the ValidatorCache. Code that only
+// builds responses in memory, like the router benchmark, links response.cpp without them.
+
+/**
+ * @brief Reads the content from an HTML file and sets it as the HTTP response content.
+ * @param relativeFilePath The relative path of the HTML file to be read and served as the HTTP response content.
+ */
+void Response::render_template(const std::string &relativeFilePath){
+    readHTMLFile(relativeFilePath);
+}
+
+/**
+ * @brief Reads the content from an HTML file and sets it as the HTTP response content.
+ *
+ * The file is read once and kept in the ValidatorCache, later responses share its content until
+ * the file changes. The response carries the file's `ETag` and `Last-Modified` headers, so the
+ * server answers a conditional request for an unchanged template with `304 Not Modified`.
+ *
+ * @param relativeFilePath The relative path of the HTML file to be read and served as the HTTP response content.
+ */
+void Response::readHTMLFile(const std::string &relativeFilePath){
+    // Construct the full file path by appending the relative file path to the templates directory
+    std::string fullFilePath = "./templates/"+relativeFilePath;
+
+    std::shared_ptr<const ValidatorCache::CachedFile> cachedFile = ValidatorCache::global().lookup(fullFilePath, ValidatorCache::LOAD_CONTENT);
+
+     // If the file cannot be read, set an error response and return
+    if (!cachedFile) {
+        std::cerr << "File not found: " << fullFilePath << std::endl;
+        httpBody.setString("File not found");
+        httpStatusCode = 404;
+        httpContentType = "text/plain";
+        return;
+    }
+    httpBody.setSharedBuffer(cachedFile->content);
+    httpContentType = "text/html";
+    httpHeaders.set(HttpHeader::ETAG, cachedFile->etag);
+    httpHeaders.set(HttpHeader::LAST_MODIFIED, cachedFile->lastModified);
+}
+
+/**
+ * @brief Sets the status of a file that cannot be served.
+ *
+ * @param httpStatusCode The status code to set.
+ * @param httpContentType The content type to set.
+ * @param httpBody The body to set.
+ */
+static void setFileNotFound(int &httpStatusCode, std::string &httpContentType, ResponseBody &httpBody){
+    httpStatusCode = 404;
+    httpContentType = "text/plain";
+    httpBody.setString("File not found");
+}
+
+/**
+ * @brief Serves a file to be included in an HTTP response.
+ * 
+ * @param filePath The path to the file to be served.
+ * @param directory The directory where the file is located.
+ * 
+ * This method opens the specified file from the given directory, determines its
+ * MIME type, and sets the file as the content of the response. The file is not
+ * read into memory, the server sends it with TransmitFile.
+ * 
+ * If the file is successfully opened, it sets the HTTP status code to "200 OK",
+ * the MIME type based on the file's extension and the file's `ETag` and
+ * `Last-Modified` headers. If the file is not found or cannot be opened, it sets
+ * the HTTP status code to "404 Not Found" and returns a plain text response
+ * indicating that the file was not found.
+ */
+void Response::serveFile(const std::string &filePath, const std::string &directory){
+    std::string fullPath = "."+ directory + filePath;
+    std::shared_ptr<const ValidatorCache::CachedFile> cachedFile = ValidatorCache::global().lookup(fullPath);
+    FileRegion fileRegion = cachedFile ? FileRegion::open(fullPath) : FileRegion();
+    if (!fileRegion.isOpen()) {
+        setFileNotFound(httpStatusCode, httpContentType, httpBody);
+        return;
+    }
+    httpContentType = getMimeType(fullPath);
+    httpBody.setFileRegion(std::move(fileRegion));
+    httpHeaders.set(HttpHeader::ETAG, cachedFile->etag);
+    httpHeaders.set(HttpHeader::LAST_MODIFIED, cachedFile->lastModified);
+    httpStatusCode = 200;
+}
+
+/**
+ * @brief Serves a file in answer to a request, with `304 Not Modified` if the client's copy is current.
+ *
+ * The validators of the file come from the ValidatorCache. If the request's `If-None-Match` or
+ * `If-Modified-Since` header matches them, the response is a header-only 304 and the file is not
+ * opened at all.
+ *
+ * With precompressed set, a precompressed sibling of the file is served instead if the client
+ * accepts it. Siblings are built ahead of time next to the file, with the extension of their
+ * encoding added: `index.css.br` for brotli and `index.css.gz` for gzip. The sibling is sent with
+ * `Content-Encoding` set, the content type of the original file and the sibling's own ETag, since
+ * its bytes differ. It is sent with TransmitFile like any file, so serving it costs no CPU for
+ * compression. `Vary: Accept-Encoding` is always set, since the response depends on the header.
+ * Siblings must be rebuilt whenever the file changes.
+ *
+ * The response carries `Accept-Ranges: bytes`, and the request's `Range` header is applied to the
+ * file (or sibling) as long as its `If-Range` header, if any, still matches, see setByteRanges.
+ *
+ * @param filePath The path to the file to be served.
+ * @param directory The directory where the file is located.
+ * @param request The request, whose conditional and `Accept-Encoding` headers are used.
+ * @param precompressed True to look for precompressed siblings of the file.
+ */
+void Response::serveFile(const std::string &filePath, const std::string &directory, const Request &request, bool precompressed){
+    std::string fullPath = "." + directory + filePath;
+    ValidatorCache& validatorCache = ValidatorCache::global();
+    std::shared_ptr<const ValidatorCache::CachedFile> cachedFile = validatorCache.lookup(fullPath);
+    if(!cachedFile){
+        setFileNotFound(httpStatusCode, httpContentType, httpBody);
+        return;
+    }
+
+    std::string servedPath = fullPath;
+    ContentEncoding encoding = ENCODING_IDENTITY;
+    if(precompressed){
+        httpHeaders.set(HttpHeader::VARY, "Accept-Encoding");
+
+        // Try the preferred encoding first and fall back to the other if its sibling does not exist
+        bool availableEncodings[ENCODING_COUNT] = {};
+        availableEncodings[ENCODING_BROTLI] = true;
+        availableEncodings[ENCODING_GZIP] = true;
+        for(;;){
+            encoding = negotiateContentEncoding(request.getRequestHeader("accept-encoding"), availableEncodings);
+            if(encoding == ENCODING_IDENTITY) break;
+            std::string siblingPath = fullPath + (encoding == ENCODING_BROTLI ? ".br" : ".gz");
+            std::shared_ptr<const ValidatorCache::CachedFile> sibling = validatorCache.lookup(siblingPath);
+            if(sibling){
+                cachedFile = std::move(sibling);
+                servedPath = std::move(siblingPath);
+                break;
+            }
+            availableEncodings[encoding] = false;
+        }
+    }
+
+    httpStatusCode = 200;
+    httpContentType = getMimeType(fullPath);
+    httpHeaders.set(HttpHeader::ETAG, cachedFile->etag);
+    httpHeaders.set(HttpHeader::LAST_MODIFIED, cachedFile->lastModified);
+    if(request.isNotModified(cachedFile->etag, cachedFile->lastModified)){
+        setNotModified();
+        return;
+    }
+
+    FileRegion fileRegion = FileRegion::open(servedPath);
+    if(!fileRegion.isOpen()){
+        httpHeaders.remove(HttpHeader::ETAG);
+        httpHeaders.remove(HttpHeader::LAST_MODIFIED);
+        setFileNotFound(httpStatusCode, httpContentType, httpBody);
+        return;
+    }
+    if(encoding != ENCODING_IDENTITY) httpHeaders.set(HttpHeader::CONTENT_ENCODING, contentEncodingName(encoding));
+    httpHeaders.set(HttpHeader::ACCEPT_RANGES, "bytes");
+    if(request.isRangeCurrent(cachedFile->etag, cachedFile->lastModified) && setByteRanges(request, fileRegion)) return;
+    httpBody.setFileRegion(std::move(fileRegion));
+}
+
+/**
+ * @brief Creates a boundary for a multipart/byteranges body that will not occur in the file.
+ */
+static std::string makeMultipartBoundary(){
+    static std::atomic<std::uint64_t> counter(0);
+    std::uint64_t value = static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    value ^= (counter++ + 1) * 0x9E3779B97F4A7C15ull;
+
+    char buffer[48] = "CPPWebServerRanges";
+    char* position = buffer + 18;
+    position = std::to_chars(position, buffer + sizeof(buffer), value, 16).ptr;
+    return std::string(buffer, position);
+}
+
+/**
+ * @brief Sets the ranges of a file requested with a `Range` header as the content.
+ *
+ * A single range is sent with `206 Partial Content` and a `Content-Range` header as a slice of the
+ * file, with TransmitFile from its offset like any file. Several ranges are sent as a
+ * `multipart/byteranges` body, which is generated while it is sent. Its length is computed in
+ * advance, so it is sent with a `Content-Length` rather than chunked. If no range overlaps the file
+ * the response is `416 Range Not Satisfiable`. A header that cannot be parsed is ignored.
+ *
+ * @param request The request.
+ * @param fileRegion The whole file.
+ * @return True if the response was set, false if the whole file is to be sent.
+ */
+bool Response::setByteRanges(const Request &request, const FileRegion &fileRegion){
+    const std::string& rangeHeader = request.getRequestHeader("range");
+    if(rangeHeader.empty()) return false;
+
+    std::vector<ByteRange> ranges;
+    std::uint64_t size = fileRegion.getLength();
+    switch(parseByteRanges(rangeHeader, size, ranges)){
+        case RANGE_IGNORED:
+            return false;
+        case RANGE_NOT_SATISFIABLE:
+            httpStatusCode = 416;
+            httpBody.setString(std::string());
+            httpHeaders.set(HttpHeader::CONTENT_RANGE, "bytes */" + std::to_string(size));
+            return true;
+        case RANGE_SATISFIABLE:
+            break;
+    }
+
+    httpStatusCode = 206;
+    if(ranges.size() == 1){
+        httpHeaders.set(HttpHeader::CONTENT_RANGE, formatContentRange(ranges[0], size));
+        httpBody.setFileRegion(fileRegion.slice(ranges[0].offset, ranges[0].length));
+        return true;
+    }
+    std::string boundary = makeMultipartBoundary();
+    httpBody.setGenerator(makeMultipartByteRanges(fileRegion, ranges, httpContentType, boundary), multipartByteRangesLength(ranges, size, httpContentType, boundary));
+    httpContentType = "multipart/byteranges; boundary=" + boundary;
+    return true;
+}
@@ -0,0 +1,18 @@
+#ifndef RESPONSEFUNCTION_H
+#define RESPONSEFUNCTION_H
+#include "inlinefunction.h"
+#include "response.h"
+#include "request.h"
+
+/**
+ * @brief A response function.
+ *
+ * Accepts a plain function such as `Response HomePage(Request& req)` as well as lambdas with
+ * captures and functors, stored without heap allocation (see InlineFunction):
+ * @code
+ * server.post("/api/form", [&database](Request& req){ return saveForm(req, database); });
+ * @endcode
+ */
+using ResponseFunction = InlineFunction<Response(Request&)>;
+
+#endif
@@ -0,0 +1,115 @@
+#include <utility>
+
+#include "responseheaders.h"
+#include "httpheader.h"
+
+/**
+ * @brief Copies a header name or value, replacing CR and LF so it cannot start another header.
+ */
+static void assignField(std::string &field, std::string_view text){
+    field.assign(text.data(), text.size());
+    for(char& c : field){
+        if(c == '\r' || c == '\n') c = ' ';
+    }
+}
+
+/**
+ * @brief Sets a header, replacing all headers with the same name.
+ *
+ * @param name The header name, e.g. HttpHeader::CACHE_CONTROL or "X-Request-Id". Case is ignored when comparing names.
+ * @param value The header value.
+ */
+void ResponseHeaders::set(std::string_view name, std::string_view value){
+    for(std::size_t i = 0; i < count; i++){
+        if(!HttpHeader::equals(at(i).name(), name)) continue;
+        assignField(at(i).value, value);
+        for(std::size_t j = count; j > i + 1; j--){
+            if(HttpHeader::equals(at(j - 1).name(), name)) erase(j - 1);
+        }
+        return;
+    }
+    add(name, value);
+}
+
+/**
+ * @brief Adds a header, keeping headers with the same name, e.g. for several `Set-Cookie` headers.
+ *
+ * @param name The header name.
+ * @param value The header value.
+ */
+void ResponseHeaders::add(std::string_view name, std::string_view value){
+    if(count >= inlineCapacity) overflowHeaders.emplace_back();
+    Header& header = at(count++);
+    header.internedName = HttpHeader::intern(name);
+    if(header.internedName.empty()){
+        assignField(header.ownedName, name);
+    }
+    else{
+        header.ownedName.clear();
+    }
+    assignField(header.value, value);
+}
+
+/**
+ * @brief Removes the header at a position, keeping the order of the others.
+ */
+void ResponseHeaders::erase(std::size_t index){
+    for(std::size_t i = index; i + 1 < count; i++){
+        std::swap(at(i), at(i + 1));
+    }
+    count--;
+    if(count >= inlineCapacity) overflowHeaders.pop_back();
+}
+
+/**
+ * @brief Removes all headers with a name.
+ *
+ * @param name The header name.
+ * @return True if a header was removed.
+ */
+bool ResponseHeaders::remove(std::string_view name){
+    bool removed = false;
+    for(std::size_t i = count; i > 0; i--){
+        if(HttpHeader::equals(at(i - 1).name(), name)){
+            erase(i - 1);
+            removed = true;
+        }
+    }
+    return removed;
+}
+
+/**
+ * @brief Gets the value of a header.
+ *
+ * @param name The header name.
+ * @return The value of the first header with the name, an empty view if there is none.
+ */
+std::string_view ResponseHeaders::get(std::string_view name) const{
+    for(std::size_t i = 0; i < count; i++){
+        if(HttpHeader::equals(at(i).name(), name)) return at(i).value;
+    }
+    return std::string_view();
+}
+
+/**
+ * @brief Gets the number of bytes writeTo appends.
+ */
+std::size_t ResponseHeaders::serializedSize() const{
+    std::size_t size = 0;
+    for(std::size_t i = 0; i < count; i++){
+        size += at(i).name().size() + at(i).value.size() + 4;
+    }
+    return size;
+}
+
+/**
+ * @brief Appends the headers as `Name: value` lines.
+ *
+ * @param output The buffer to append to.
+ */
+void ResponseHeaders::writeTo(std::string &output) const{
+    for(std::size_t i = 0; i < count; i++){
+        std::string_view name = at(i).name();
+        output.append(name.data(), name.size()).append(": ").append(at(i).value).append("\r\n");
+    }
+}
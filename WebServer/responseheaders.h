@@ -0,0 +1,50 @@
+#ifndef RESPONSEHEADERS_H
+#define RESPONSEHEADERS_H
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief The additional headers of a response, stored inline.
+ *
+ * The first `inlineCapacity` headers live inside the object, so a response with a few headers
+ * allocates at most for long values. Well-known names (see HttpHeader) are stored as views of the
+ * interned constants, other names are copied. Further headers spill into a vector.
+ */
+class ResponseHeaders{
+public:
+    static const std::size_t inlineCapacity = 8;   ///< Headers stored without allocating
+
+private:
+    struct Header {
+        std::string_view internedName;  ///< The interned constant of a well-known name, empty otherwise
+        std::string ownedName;          ///< A copy of the name if it is not well-known
+        std::string value;
+
+        std::string_view name() const { return internedName.empty() ? std::string_view(ownedName) : internedName; }
+    };
+
+    std::array<Header, inlineCapacity> inlineHeaders;
+    std::vector<Header> overflowHeaders;
+    std::size_t count = 0;
+
+    Header& at(std::size_t index) { return index < inlineCapacity ? inlineHeaders[index] : overflowHeaders[index - inlineCapacity]; }
+    const Header& at(std::size_t index) const { return index < inlineCapacity ? inlineHeaders[index] : overflowHeaders[index - inlineCapacity]; }
+    void erase(std::size_t index);
+
+public:
+    void set(std::string_view name, std::string_view value);
+    void add(std::string_view name, std::string_view value);
+    bool remove(std::string_view name);
+    std::string_view get(std::string_view name) const;
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    std::size_t serializedSize() const;
+    void writeTo(std::string& output) const;
+};
+
+#endif
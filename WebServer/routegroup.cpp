@@ -0,0 +1,146 @@
+#include "routegroup.h"
+
+/**
+ * @brief Creates a group without group middleware.
+ *
+ * @param prefix The path prefix of all routes in the group, e.g. "/api/v1". A trailing '/' is removed.
+ */
+RouteGroup::RouteGroup(const std::string &prefix): prefix(prefix) {
+    if(!this->prefix.empty() && this->prefix.back() == '/') this->prefix.pop_back();
+}
+
+/**
+ * @brief Creates a group whose middleware runs for all of its routes.
+ *
+ * @param prefix The path prefix of all routes in the group, e.g. "/api/v1". A trailing '/' is removed.
+ * @param middleware The group middleware.
+ */
+RouteGroup::RouteGroup(const std::string &prefix, Middleware &middleware): RouteGroup(prefix) {
+    this->middleware = middleware;
+}
+
+void RouteGroup::addRoute(HttpMethod method, const RoutePattern &route, ResponseFunction responseFunction, Middleware &middleware){
+    routes.push_back(GroupRoute{method, route, std::make_shared<ResponseFunction>(std::move(responseFunction)), middleware});
+}
+
+/**
+ * @brief Adds a GET route to the group.
+ *
+ * @param route The route relative to the group prefix, e.g. "/users/:id", or a glob or regex pattern.
+ * @param responseFunction The response function to be called when the route is accessed, a function or a lambda.
+ */
+void RouteGroup::get(RoutePattern route, ResponseFunction responseFunction){
+    Middleware middleware;
+    addRoute(HTTP_GET, route, std::move(responseFunction), middleware);
+}
+
+/**
+ * @brief Adds a GET route with middleware to the group.
+ *
+ * @param route The route relative to the group prefix, e.g. "/users/:id", or a glob or regex pattern.
+ * @param responseFunction The response function to be called when the route is accessed, a function or a lambda.
+ * @param middleware The route's middleware, executed after the group middleware.
+ */
+void RouteGroup::get(RoutePattern route, ResponseFunction responseFunction, Middleware &middleware){
+    addRoute(HTTP_GET, route, std::move(responseFunction), middleware);
+}
+
+/**
+ * @brief Adds a POST route to the group.
+ *
+ * @param route The route relative to the group prefix, or a glob or regex pattern.
+ * @param responseFunction The response function to be called when the route is accessed, a function or a lambda.
+ */
+void RouteGroup::post(RoutePattern route, ResponseFunction responseFunction){
+    Middleware middleware;
+    addRoute(HTTP_POST, route, std::move(responseFunction), middleware);
+}
+
+/**
+ * @brief Adds a POST route with middleware to the group.
+ *
+ * @param route The route relative to the group prefix, or a glob or regex pattern.
+ * @param responseFunction The response function to be called when the route is accessed, a function or a lambda.
+ * @param middleware The route's middleware, executed after the group middleware.
+ */
+void RouteGroup::post(RoutePattern route, ResponseFunction responseFunction, Middleware &middleware){
+    addRoute(HTTP_POST, route, std::move(responseFunction), middleware);
+}
+
+/**
+ * @brief Adds a PUT route to the group.
+ *
+ * @param route The route relative to the group prefix, or a glob or regex pattern.
+ * @param responseFunction The response function to be called when the route is accessed, a function or a lambda.
+ */
+void RouteGroup::put(RoutePattern route, ResponseFunction responseFunction){
+    Middleware middleware;
+    addRoute(HTTP_PUT, route, std::move(responseFunction), middleware);
+}
+
+/**
+ * @brief Adds a PUT route with middleware to the group.
+ *
+ * @param route The route relative to the group prefix, or a glob or regex pattern.
+ * @param responseFunction The response function to be called when the route is accessed, a function or a lambda.
+ * @param middleware The route's middleware, executed after the group middleware.
+ */
+void RouteGroup::put(RoutePattern route, ResponseFunction responseFunction, Middleware &middleware){
+    addRoute(HTTP_PUT, route, std::move(responseFunction), middleware);
+}
+
+/**
+ * @brief Adds a PATCH route to the group.
+ *
+ * @param route The route relative to the group prefix, or a glob or regex pattern.
+ * @param responseFunction The response function to be called when the route is accessed, a function or a lambda.
+ */
+void RouteGroup::patch(RoutePattern route, ResponseFunction responseFunction){
+    Middleware middleware;
+    addRoute(HTTP_PATCH, route, std::move(responseFunction), middleware);
+}
+
+/**
+ * @brief Adds a PATCH route with middleware to the group.
+ *
+ * @param route The route relative to the group prefix, or a glob or regex pattern.
+ * @param responseFunction The response function to be called when the route is accessed, a function or a lambda.
+ * @param middleware The route's middleware, executed after the group middleware.
+ */
+void RouteGroup::patch(RoutePattern route, ResponseFunction responseFunction, Middleware &middleware){
+    addRoute(HTTP_PATCH, route, std::move(responseFunction), middleware);
+}
+
+/**
+ * @brief Adds a DELETE route to the group.
+ *
+ * @param route The route relative to the group prefix, or a glob or regex pattern.
+ * @param responseFunction The response function to be called when the route is accessed, a function or a lambda.
+ */
+void RouteGroup::del(RoutePattern route, ResponseFunction responseFunction){
+    Middleware middleware;
+    addRoute(HTTP_DELETE, route, std::move(responseFunction), middleware);
+}
+
+/**
+ * @brief Adds a DELETE route with middleware to the group.
+ *
+ * @param route The route relative to the group prefix, or a glob or regex pattern.
+ * @param responseFunction The response function to be called when the route is accessed, a function or a lambda.
+ * @param middleware The route's middleware, executed after the group middleware.
+ */
+void RouteGroup::del(RoutePattern route, ResponseFunction responseFunction, Middleware &middleware){
+    addRoute(HTTP_DELETE, route, std::move(responseFunction), middleware);
+}
+
+/**
+ * @brief Mounts a subgroup below this group's prefix.
+ *
+ * The subgroup's prefix is relative to this group's, and its routes run this group's middleware
+ * before their own group's.
+ *
+ * @param group The subgroup, which is copied.
+ */
+void RouteGroup::mount(const RouteGroup &group){
+    subgroups.push_back(group);
+}
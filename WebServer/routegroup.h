@@ -0,0 +1,73 @@
+#ifndef ROUTEGROUP_H
+#define ROUTEGROUP_H
+#include <memory>
+#include <string>
+#include <vector>
+#include "httpmethod.h"
+#include "routepattern.h"
+#include "response.h"
+#include "request.h"
+#include "middleware.h"
+#include "responsefunction.h"
+
+/**
+ * @brief A group of routes that share a path prefix and middleware (a blueprint).
+ *
+ * Routes are registered on the group relative to its prefix and the group is then mounted on the
+ * server, or on another group:
+ * @code
+ * Middleware apiMiddleware;
+ * apiMiddleware.push(checkApiKey);
+ *
+ * RouteGroup api("/api/v1", apiMiddleware);
+ * api.get("/users", &listUsers);              // GET /api/v1/users
+ * api.get("/users/:id", &getUser);            // GET /api/v1/users/:id
+ * server.mount(api);
+ * @endcode
+ *
+ * When mounted, the prefix becomes one node of the radix tree and the group's routes its subtree,
+ * so a lookup matches the prefix once. The group middleware is stored on that node and composed
+ * into the middleware chain of every route below it, for every method, when the routes are frozen.
+ * It runs after the middleware of enclosing groups and routes and before the route's own middleware.
+ *
+ * The group is copied when it is mounted, routes added to it afterwards are not served.
+ */
+class RouteGroup{
+private:
+    struct GroupRoute {
+        HttpMethod method;
+        RoutePattern route;
+        std::shared_ptr<ResponseFunction> responseFunction;
+        Middleware middleware;
+    };
+
+    std::string prefix;
+    Middleware middleware;      ///< Runs for every route of the group and its subgroups
+    std::vector<GroupRoute> routes;
+    std::vector<RouteGroup> subgroups;
+
+    void addRoute(HttpMethod method, const RoutePattern& route, ResponseFunction responseFunction, Middleware &middleware);
+
+public:
+    explicit RouteGroup(const std::string& prefix);
+    RouteGroup(const std::string& prefix, Middleware &middleware);
+
+    void get(RoutePattern route, ResponseFunction responseFunction);
+    void get(RoutePattern route, ResponseFunction responseFunction, Middleware &middleware);
+    void post(RoutePattern route, ResponseFunction responseFunction);
+    void post(RoutePattern route, ResponseFunction responseFunction, Middleware &middleware);
+    void put(RoutePattern route, ResponseFunction responseFunction);
+    void put(RoutePattern route, ResponseFunction responseFunction, Middleware &middleware);
+    void patch(RoutePattern route, ResponseFunction responseFunction);
+    void patch(RoutePattern route, ResponseFunction responseFunction, Middleware &middleware);
+    void del(RoutePattern route, ResponseFunction responseFunction);
+    void del(RoutePattern route, ResponseFunction responseFunction, Middleware &middleware);
+
+    void mount(const RouteGroup& group);
+
+    const std::string& getPrefix() const { return prefix; }
+
+    friend class RadixTree;
+};
+
+#endif
@@ -0,0 +1,48 @@
+#include <array>
+#include "routematch.h"
+#include "radixnode.h"
+
+/**
+ * @brief Gets the `Allow` header value of the routes that match the path.
+ *
+ * The values for every combination of methods are serialized once, so answering a
+ * request with 405 Method Not Allowed does not allocate.
+ *
+ * @return The registered methods, e.g. "GET, POST", or an empty string if no route matched.
+ */
+const std::string& RouteMatch::getAllowHeader() const{
+    static const std::array<std::string, 1u << HTTP_METHOD_COUNT> allowHeaders = []{
+        std::array<std::string, 1u << HTTP_METHOD_COUNT> headers;
+        for(unsigned methods = 0; methods < headers.size(); methods++){
+            for(int method = 0; method < HTTP_METHOD_COUNT; method++){
+                if(!(methods & (1u << method))) continue;
+                if(!headers[methods].empty()) headers[methods] += ", ";
+                headers[methods] += httpMethodName(static_cast<HttpMethod>(method));
+            }
+        }
+        return headers;
+    }();
+    return allowHeaders[allowedMethods];
+}
+
+/**
+ * @brief Gets the middleware functions that run before the response function, in order.
+ *
+ * @return The global, group, parent route and route middleware composed by RadixTree::freeze, or an
+ *         empty chain if the route is not registered for the request method.
+ */
+const std::vector<MiddlewareFunction*>& RouteMatch::getMiddlewareChain() const{
+    static const std::vector<MiddlewareFunction*> noMiddlewareChain;
+    return responseFunction ? node->middlewareChains[method] : noMiddlewareChain;
+}
+
+/**
+ * @brief Gets the after hooks that run once the response function returned, in order.
+ *
+ * @return The route's after hooks followed by those of its groups, parent routes and the global
+ *         middleware, or an empty chain if the route is not registered for the request method.
+ */
+const std::vector<AfterHook*>& RouteMatch::getAfterHookChain() const{
+    static const std::vector<AfterHook*> noAfterHookChain;
+    return responseFunction ? node->afterHookChains[method] : noAfterHookChain;
+}
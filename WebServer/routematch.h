@@ -0,0 +1,64 @@
+#ifndef ROUTEMATCH_H
+#define ROUTEMATCH_H
+#include <optional>
+#include <string>
+#include <vector>
+#include "httpmethod.h"
+#include "routeparams.h"
+#include "response.h"
+#include "request.h"
+#include "responsefunction.h"
+#include "middlewarefunction.h"
+#include "afterhook.h"
+
+class RadixNode;
+
+/**
+ * @brief The result of a route lookup.
+ *
+ * Returned by value from RadixTree::search, so a lookup lives on the caller's stack and performs no
+ * heap allocation: it holds the matched route, the response function for the request method, the
+ * captured parameters (inline, see RouteParams) and, once RadixTree::executeMiddleware has run, the
+ * response of the middleware function that interrupted the request, if any.
+ */
+class RouteMatch{
+private:
+    RadixNode* node = nullptr;      ///< The matched route, or the first route that matches the path if none is registered for the method, nullptr if no route matches the path
+    HttpMethod method = HTTP_METHOD_COUNT;
+    ResponseFunction* responseFunction = nullptr;   ///< nullptr if the route is not registered for the method
+    unsigned allowedMethods = 0;    ///< One bit per method registered on the routes that match the path, complete if the method is not allowed
+    RouteParams routeParams;
+    std::optional<Response> middlewareResponse;     ///< Set if a middleware function interrupted the request
+
+public:
+    /**
+     * @brief Checks whether a route matches the path.
+     *
+     * @return True if a route matches, regardless of the method.
+     */
+    bool found() const { return node != nullptr; }
+
+    /**
+     * @brief Checks whether the matched route is registered for the request method.
+     *
+     * @return True if a response function was found.
+     */
+    bool methodAllowed() const { return responseFunction != nullptr; }
+
+    /**
+     * @brief Checks whether a middleware function answered the request.
+     *
+     * @return True if the middleware chain was interrupted.
+     */
+    bool interrupted() const { return middlewareResponse.has_value(); }
+
+    const std::string& getAllowHeader() const;
+    const RouteParams& getRouteParams() const { return routeParams; }
+    const std::vector<MiddlewareFunction*>& getMiddlewareChain() const;
+    const std::vector<AfterHook*>& getAfterHookChain() const;
+
+    friend class RadixTree;
+    friend class WebServer;
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef ROUTEPARAMS_H
+#define ROUTEPARAMS_H
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+/**
+ * @brief The parameters captured by a route, stored inline.
+ *
+ * A fixed-capacity list of (name, value) pairs. The names are views into the parameter names the
+ * router interns for the lifetime of the program, the values views into the request path. Since
+ * the storage is part of the object, capturing parameters never allocates. The RadixTree rejects
+ * routes with more than `capacity` parameters.
+ */
+class RouteParams{
+public:
+    static const std::size_t capacity = 8;     ///< Maximum number of parameters and wildcards in one route
+
+private:
+    std::array<std::pair<std::string_view, std::string_view>, capacity> params;
+    std::size_t count = 0;
+
+public:
+    /**
+     * @brief Appends a parameter. Ignored if the list is full.
+     *
+     * @param name The parameter name.
+     * @param value The captured value.
+     */
+    void push_back(std::string_view name, std::string_view value){
+        if(count < capacity) params[count++] = {name, value};
+    }
+
+    /**
+     * @brief Drops the parameters after the first `size` ones.
+     *
+     * @param size The number of parameters to keep.
+     */
+    void truncate(std::size_t size){
+        if(size < count) count = size;
+    }
+
+    void clear() { count = 0; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    const std::pair<std::string_view, std::string_view>& operator[](std::size_t index) const { return params[index]; }
+    const std::pair<std::string_view, std::string_view>* begin() const { return params.data(); }
+    const std::pair<std::string_view, std::string_view>* end() const { return params.data() + count; }
+};
+
+#endif
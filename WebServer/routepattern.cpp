@@ -0,0 +1,37 @@
+#include "routepattern.h"
+
+RoutePattern::RoutePattern(Kind kind, const std::string &pattern): kind(kind), pattern(pattern) {}
+
+/**
+ * @brief Creates a radix tree route, e.g. "/users/:id".
+ *
+ * @param route The route.
+ */
+RoutePattern::RoutePattern(const std::string &route): kind(PATH), pattern(route) {}
+
+/**
+ * @brief Creates a radix tree route from a string literal, e.g. "/users/:id".
+ *
+ * @param route The route.
+ */
+RoutePattern::RoutePattern(const char *route): kind(PATH), pattern(route) {}
+
+/**
+ * @brief Creates a glob route, e.g. "/files/report-*.pdf".
+ *
+ * @param pattern The glob pattern.
+ * @return The route pattern.
+ */
+RoutePattern RoutePattern::glob(const std::string &pattern){
+    return RoutePattern(GLOB, pattern);
+}
+
+/**
+ * @brief Creates a regular expression route, e.g. "/v[0-9]+/items".
+ *
+ * @param pattern The regular expression, implicitly anchored at both ends.
+ * @return The route pattern.
+ */
+RoutePattern RoutePattern::regex(const std::string &pattern){
+    return RoutePattern(REGEX, pattern);
+}
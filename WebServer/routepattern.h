@@ -0,0 +1,42 @@
+#ifndef ROUTEPATTERN_H
+#define ROUTEPATTERN_H
+#include <string>
+
+/**
+ * @brief Describes the route a response function is registered for.
+ *
+ * A plain string is a radix tree route, which may contain `:param` and trailing `*wildcard`
+ * segments. Glob and regular expression patterns are created with the static factory functions
+ * and must match the whole request path:
+ *   - `RoutePattern::glob("/files/report-*.pdf")`: `*` matches within one segment, `**` across segments,
+ *     `?` matches one character and `[...]` a character class.
+ *   - `RoutePattern::regex("/v[0-9]+/items")`: literals, `.`, `[...]` classes, `\d`, `\w`, `\s`,
+ *     groups `( )`, alternation `|` and the quantifiers `*`, `+` and `?`. Other syntax, such as
+ *     `{n,m}` or `\b`, is rejected with std::runtime_error rather than matched literally.
+ *
+ * All glob and regex routes are compiled together into a single DFA (see PatternDFA).
+ */
+class RoutePattern{
+public:
+    enum Kind { PATH, GLOB, REGEX };
+
+private:
+    Kind kind;
+    std::string pattern;
+
+    RoutePattern(Kind kind, const std::string& pattern);
+
+public:
+    RoutePattern(const std::string& route);
+    RoutePattern(const char* route);
+
+    static RoutePattern glob(const std::string& pattern);
+    static RoutePattern regex(const std::string& pattern);
+
+    Kind getKind() const { return kind; }
+    const std::string& getPattern() const { return pattern; }
+
+    bool operator==(const RoutePattern& other) const { return kind == other.kind && pattern == other.pattern; }
+};
+
+#endif
@@ -0,0 +1,228 @@
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "router.h"
+
+Router::Router(): published(false), currentTree(new RadixTree()), globalEpoch(1) {
+    for(std::atomic<std::uint64_t>& readerEpoch : readerEpochs){
+        readerEpoch.store(0);
+    }
+}
+
+/**
+ * @brief Deletes the current and all retired snapshots. No reader may be active.
+ */
+Router::~Router(){
+    delete currentTree.load();
+    for(std::pair<RadixTree*, std::uint64_t>& retiredTree : retiredTrees){
+        delete retiredTree.first;
+    }
+}
+
+/**
+ * @brief Builds a complete, frozen snapshot from the route definitions.
+ *
+ * @return The new tree, owned by the caller.
+ * @throw std::runtime_error if the definitions cannot be inserted, e.g. because a route is defined twice.
+ */
+RadixTree *Router::buildTree(){
+    std::unique_ptr<RadixTree> tree(new RadixTree());
+    for(const Middleware& middleware : globalMiddleware){
+        tree->use(middleware);
+    }
+    for(RouteDefinition& definition : routes){
+        tree->insert(definition.method, definition.route, definition.responseFunction, definition.middleware);
+    }
+    for(const RouteGroup& group : groups){
+        tree->mount(group);
+    }
+    tree->freeze();
+    tree->bindStaticRoutes(staticRoutes);
+    return tree.release();
+}
+
+/**
+ * @brief Publishes a new snapshot and retires the old one. Must be called with writerMutex held.
+ *
+ * Readers that entered before the epoch is advanced may still use the old snapshot, readers
+ * that enter afterwards load the new one.
+ *
+ * @param tree The new snapshot.
+ */
+void Router::swapTree(RadixTree *tree){
+    RadixTree* oldTree = currentTree.exchange(tree);
+    retiredTrees.emplace_back(oldTree, globalEpoch.fetch_add(1));
+    reclaimRetiredTrees();
+}
+
+/**
+ * @brief Deletes the retired snapshots that no active reader can still use. Must be called with writerMutex held.
+ */
+void Router::reclaimRetiredTrees(){
+    std::uint64_t oldestReaderEpoch = UINT64_MAX;
+    for(std::atomic<std::uint64_t>& readerEpoch : readerEpochs){
+        std::uint64_t epoch = readerEpoch.load();
+        if(epoch != 0 && epoch < oldestReaderEpoch) oldestReaderEpoch = epoch;
+    }
+
+    std::size_t kept = 0;
+    for(std::pair<RadixTree*, std::uint64_t>& retiredTree : retiredTrees){
+        if(retiredTree.second < oldestReaderEpoch){
+            delete retiredTree.first;
+        }
+        else{
+            retiredTrees[kept++] = retiredTree;
+        }
+    }
+    retiredTrees.resize(kept);
+}
+
+/**
+ * @brief Adds a route for one method.
+ *
+ * Before `publish()` the route is inserted into the initial snapshot. Afterwards a new snapshot
+ * containing the route is built and swapped in, requests in flight finish with the old one.
+ *
+ * @throw std::runtime_error if the route is already defined for the method or is invalid. The routes are left unchanged.
+ */
+void Router::addRoute(HttpMethod method, const RoutePattern &route, ResponseFunction responseFunction, Middleware &middleware){
+    std::lock_guard<std::mutex> lock(writerMutex);
+    routes.push_back(RouteDefinition{method, route, std::make_shared<ResponseFunction>(std::move(responseFunction)), middleware});
+    try{
+        if(!published){
+            currentTree.load()->insert(method, route, routes.back().responseFunction, middleware);
+        }
+        else{
+            swapTree(buildTree());
+        }
+    }
+    catch(...){
+        routes.pop_back();
+        throw;
+    }
+}
+
+/**
+ * @brief Removes the route registered for a method and route.
+ *
+ * A new snapshot without the route is built and swapped in, requests in flight finish with the old one.
+ *
+ * @param method The method the route was registered for.
+ * @param route The route, exactly as it was registered.
+ * @return True if the route was removed, false if no such route is registered.
+ */
+bool Router::removeRoute(HttpMethod method, const RoutePattern &route){
+    std::lock_guard<std::mutex> lock(writerMutex);
+    for(std::vector<RouteDefinition>::iterator it = routes.begin(); it != routes.end(); it++){
+        if(it->method == method && it->route == route){
+            routes.erase(it);
+            swapTree(buildTree());
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Mounts a route group.
+ *
+ * Like `addRoute()`, the group is inserted into the initial snapshot before `publish()` and swapped
+ * in as part of a new snapshot afterwards.
+ *
+ * @param group The group, which is copied.
+ * @throw std::runtime_error if a route of the group is already defined or invalid. The routes are left unchanged.
+ */
+void Router::mount(const RouteGroup &group){
+    std::lock_guard<std::mutex> lock(writerMutex);
+    groups.push_back(group);
+    try{
+        if(!published){
+            currentTree.load()->mount(group);
+        }
+        else{
+            swapTree(buildTree());
+        }
+    }
+    catch(...){
+        groups.pop_back();
+        throw;
+    }
+}
+
+/**
+ * @brief Adds global middleware, which runs for every route.
+ *
+ * @param middleware The middleware, which is copied.
+ */
+void Router::use(const Middleware &middleware){
+    std::lock_guard<std::mutex> lock(writerMutex);
+    globalMiddleware.push_back(middleware);
+    try{
+        if(!published){
+            currentTree.load()->use(middleware);
+        }
+        else{
+            swapTree(buildTree());
+        }
+    }
+    catch(...){
+        globalMiddleware.pop_back();
+        throw;
+    }
+}
+
+/**
+ * @brief Sets the routes of the static route table, which every snapshot binds to its nodes.
+ *
+ * The routes themselves are added with `addRoute()`, so they can be removed like any other.
+ *
+ * @param routes The routes of the table, in the table's order.
+ */
+void Router::setStaticRoutes(const std::vector<StaticRoute> &routes){
+    std::lock_guard<std::mutex> lock(writerMutex);
+    staticRoutes = routes;
+    if(published){
+        swapTree(buildTree());
+    }
+}
+
+/**
+ * @brief Freezes the initial snapshot and makes it available to readers.
+ *
+ * Called by WebServer::run(). From then on every change builds and swaps in a new snapshot.
+ */
+void Router::publish(){
+    std::lock_guard<std::mutex> lock(writerMutex);
+    currentTree.load()->freeze();
+    currentTree.load()->bindStaticRoutes(staticRoutes);
+    published = true;
+}
+
+/**
+ * @brief Enters the current epoch and loads the current snapshot.
+ *
+ * Claims a free reader slot without locking. If all slots are in use, waits for one to be released.
+ *
+ * @param router The router to read from.
+ */
+Router::ReadGuard::ReadGuard(Router &router): router(router), slot(0), tree(nullptr) {
+    while(true){
+        std::uint64_t epoch = router.globalEpoch.load();
+        for(slot = 0; slot < maxReaders; slot++){
+            std::uint64_t freeSlot = 0;
+            if(router.readerEpochs[slot].compare_exchange_strong(freeSlot, epoch)){
+                tree = router.currentTree.load();
+                return;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * @brief Leaves the epoch. The snapshot may be deleted by the next writer.
+ */
+Router::ReadGuard::~ReadGuard(){
+    router.readerEpochs[slot].store(0);
+}
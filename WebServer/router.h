@@ -0,0 +1,90 @@
+#ifndef ROUTER_H
+#define ROUTER_H
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "radixtree.h"
+#include "routepattern.h"
+
+/**
+ * @brief Holds the server's routes and allows them to change while requests are being served.
+ *
+ * Requests are routed through an immutable RadixTree snapshot published through an atomic pointer.
+ * Readers take no locks: a ReadGuard announces the reader in an epoch slot and loads the current
+ * snapshot, which stays valid until the guard is destroyed.
+ *
+ * Writers serialize on a mutex. Each change builds a complete new snapshot from the route
+ * definitions and swaps it in. The old snapshot is retired with the epoch in which it was replaced
+ * and is deleted once no reader that could still see it is active (epoch-based reclamation).
+ *
+ * Until `publish()` is called, i.e. before the server runs, routes are inserted directly into the
+ * initial snapshot, so registering many routes does not rebuild the tree for each of them.
+ */
+class Router{
+private:
+    struct RouteDefinition {
+        HttpMethod method;
+        RoutePattern route;
+        std::shared_ptr<ResponseFunction> responseFunction;     ///< Shared by all snapshots built from the definition
+        Middleware middleware;
+    };
+
+    static const std::size_t maxReaders = 64;     ///< Number of requests that can read the routes at the same time
+
+    std::mutex writerMutex;     ///< Serializes writers, readers never take it
+    std::vector<RouteDefinition> routes;    ///< The definitions every new snapshot is built from
+    std::vector<RouteGroup> groups;         ///< The mounted groups every new snapshot is built from
+    std::vector<Middleware> globalMiddleware;   ///< The global middleware every new snapshot is built with
+    std::vector<StaticRoute> staticRoutes;      ///< The routes of the static route table, bound to every new snapshot
+    bool published;             ///< Whether readers may use the current snapshot, set by publish()
+
+    std::atomic<RadixTree*> currentTree;
+    std::atomic<std::uint64_t> globalEpoch;
+    std::array<std::atomic<std::uint64_t>, maxReaders> readerEpochs;    ///< Epoch each active reader entered in, 0 for a free slot
+    std::vector<std::pair<RadixTree*, std::uint64_t>> retiredTrees;      ///< Replaced snapshots and the epoch in which they were replaced
+
+    RadixTree* buildTree();
+    void swapTree(RadixTree* tree);
+    void reclaimRetiredTrees();
+
+public:
+    /**
+     * @brief Gives a reader access to the current route snapshot.
+     *
+     * The snapshot, and everything a RouteMatch or Request refers to in it, stays valid for the
+     * lifetime of the guard, even if the routes are changed meanwhile.
+     */
+    class ReadGuard{
+    private:
+        Router& router;
+        std::size_t slot;
+        RadixTree* tree;
+
+    public:
+        explicit ReadGuard(Router& router);
+        ~ReadGuard();
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        RadixTree* operator->() const { return tree; }
+        RadixTree& operator*() const { return *tree; }
+    };
+
+    Router();
+    ~Router();
+    Router(const Router&) = delete;
+    Router& operator=(const Router&) = delete;
+
+    void addRoute(HttpMethod method, const RoutePattern& route, ResponseFunction responseFunction, Middleware &middleware);
+    bool removeRoute(HttpMethod method, const RoutePattern& route);
+    void mount(const RouteGroup& group);
+    void use(const Middleware& middleware);
+    void setStaticRoutes(const std::vector<StaticRoute>& routes);
+    void publish();
+};
+
+#endif
@@ -3,12 +3,24 @@
 #include "response.h"
 #include "request.h"
 #include "middleware.h"
+#include <mswsock.h>
+#include <io.h>
 #include <iostream>
 #include <string>
 #include <cstring>
 #include <sstream>
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <chrono>
 
 #pragma comment(lib, "ws2_32.lib")
+#pragma comment(lib, "mswsock.lib")
+
+static const std::size_t generatorChunkSize = 16 * 1024;        ///< Capacity offered to a BodyGenerator per call, one chunk each
+static const std::uint64_t transmitFileChunkSize = 1 << 30;     ///< TransmitFile sends at most 2^31 - 2 bytes per call
+static const std::chrono::milliseconds lingerTimeout(2000);     ///< How long an unread request body is discarded before closing, see discardUnreadBody
+static const DWORD lingerReceiveTimeout = 500;                  ///< The receive timeout in milliseconds while an unread body is discarded
 
 
 /**
@@ -157,6 +169,8 @@ int WebServer::bindSocketToAddress()
  */
 int WebServer::run()
 {
+    router.publish();
+
     if( listenForConnections() == 1 ){
         throw std::runtime_error("Failed to listen to connections");
     }
@@ -223,65 +237,154 @@ int WebServer::acceptConnectionRequest(){
 }
 
 /**
- * Check if a string starts with a given prefix.
+ * Set one of the server's own JSON error responses.
+ *
+ * @param response The response to set.
+ * @param statusCode The HTTP status code.
+ * @param jsonContent The JSON body.
+ */
+static void setErrorResponse(Response &response, int statusCode, const char* jsonContent){
+    response.setStatusCode(statusCode);
+    response.setContentType("application/json");
+    response.setContent(jsonContent);
+}
+
+/**
+ * Receive the request line and headers of a client request.
  * 
- * This function checks if the given string `str` starts with the specified prefix.
+ * This function reads from the client socket until the blank line terminating the header
+ * section has been received. Any body bytes that arrive in the same reads are left at the
+ * end of `rawRequest`; the rest of the body is read later by `receiveRequestBody`, so that
+ * a request can be rejected before its body is uploaded.
  * 
- * @param str The string to check.
- * @param prefix The prefix to check for.
- * @return True if `str` starts with `prefix`, otherwise false.
+ * @param rawRequest Receives the raw request text. Left empty if the client closed the connection.
+ * @return 0 on success, 1 on failure.
  */
-bool WebServer::startsWith(const std::string &str, const std::string &prefix){
-    return str.compare(0, prefix.size(), prefix) == 0;
-}
+int WebServer::receiveRequestHeaders(std::string &rawRequest){
+    const int recvbuflen = 8192;
+    char recvbuf[recvbuflen];
 
+    while(rawRequest.find("\r\n\r\n") == std::string::npos){
+        if(rawRequest.size() >= recvbuflen){
+            // Dropped like a closed connection, a single oversized request should not stop the server
+            std::cerr << "Request headers exceed " << recvbuflen << " bytes" << std::endl;
+            rawRequest.clear();
+            return 0;
+        }
+
+        int iResult = recv(clientSocket, recvbuf, recvbuflen, 0);
+
+        if( iResult == SOCKET_ERROR ){
+            std::cerr << "Recv failed: " << WSAGetLastError() << std::endl;
+            return 1;
+        }
+        else if ( iResult == 0 ){
+            // Connection closed by the client. Whatever was received is handled as the complete request.
+            return 0;
+        }
+
+        rawRequest.append(recvbuf, iResult);
+    }
+    return 0;
+}
 
 /**
- * Get the remaining path after removing a prefix.
+ * Receive the remainder of the request body.
  * 
- * This function removes the specified prefix from the given string `str` and returns
- * the remaining path.
+ * This function reads the body bytes announced by the Content-Length header that did not arrive
+ * together with the headers. If the client sent `Expect: 100-continue`, it is still waiting for
+ * permission to upload, so an interim `100 Continue` response is sent first. It is only called once
+ * the route and its middleware have accepted the request, so rejected uploads are never read.
+ * The body is then parsed into the request object.
  * 
- * @param str The string from which to remove the prefix.
- * @param prefix The prefix to remove.
- * @return The remaining path after removing the prefix, or an empty string if the prefix
- *         is not found in `str`.
+ * @param requestObject The request whose body is received.
+ * @return 0 on success, 1 on failure.
  */
-std::string WebServer::getRemainingPath(const std::string &str, const std::string &prefix) {
-    if (str.compare(0, prefix.size(), prefix) == 0) {
-        return str.substr(prefix.size());
+int WebServer::receiveRequestBody(Request &requestObject){
+    if(requestObject.bodyReceived) return 0;
+    requestObject.bodyReceived = true;
+
+    if(requestObject.expectsContinue() && requestObject.rawBody.size() < requestObject.contentLength){
+        const std::string continueResponse = "HTTP/1.1 100 Continue\r\n\r\n";
+        iResult = send(clientSocket, continueResponse.c_str(), (int)continueResponse.length(), 0);
+        if (iResult == SOCKET_ERROR) {
+            std::cerr << "Send failed: " << WSAGetLastError() << std::endl;
+            return 1;
+        }
     }
-    return "";
+
+    const int recvbuflen = 8192;
+    char recvbuf[recvbuflen];
+
+    while(requestObject.rawBody.size() < requestObject.contentLength){
+        std::size_t remaining = requestObject.contentLength - requestObject.rawBody.size();
+        int iResult = recv(clientSocket, recvbuf, (int)std::min<std::size_t>(remaining, recvbuflen), 0);
+
+        if( iResult == SOCKET_ERROR ){
+            std::cerr << "Recv failed: " << WSAGetLastError() << std::endl;
+            return 1;
+        }
+        else if ( iResult == 0 ){
+            std::cerr << "Connection closed before the request body was received" << std::endl;
+            return 1;
+        }
+
+        requestObject.rawBody.append(recvbuf, iResult);
+    }
+
+    const std::string& method = requestObject.getRequestType();
+    if (method == "POST" || method == "PUT" || method == "PATCH" || method == "DELETE") {
+        requestObject.parseRequestBody(requestObject.rawBody);
+    }
+    return 0;
+}
+
+/**
+ * Discard what the client still sends of a request body that was not read.
+ * 
+ * Closing a socket with unread received data resets the connection, and the client may then lose
+ * the response before reading it. After the response has been sent and the sending side shut down,
+ * the body is therefore read and discarded until the client closes the connection, for at most
+ * lingerTimeout. A client that keeps uploading for longer may still see a reset.
+ */
+void WebServer::discardUnreadBody(){
+    setsockopt(clientSocket, SOL_SOCKET, SO_RCVTIMEO, (const char*)&lingerReceiveTimeout, sizeof(lingerReceiveTimeout));
+
+    const int recvbuflen = 8192;
+    char recvbuf[recvbuflen];
+
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + lingerTimeout;
+    while(std::chrono::steady_clock::now() < deadline && recv(clientSocket, recvbuf, recvbuflen, 0) > 0){}
 }
 
 /**
  * Handle a client request.
  * 
- * This function handles a client request by receiving the request data, parsing it to extract
+ * This function handles a client request by receiving the request headers, parsing them to extract
  * the method and route, processing the request based on the method and route, generating an
  * appropriate HTTP response, and sending the response back to the client.
  * 
+ * The request body is received before routing, unless the client sent `Expect: 100-continue`.
+ * In that case the body is only requested once the route's middleware accepted the request.
+ * A request with an invalid Content-Length is answered with 400 and one whose Content-Length
+ * exceeds the maximum body size (see setMaxBodySize) with 413, before any of its body is read.
+ * Responses to requests whose body was not read carry `Connection: close`.
+ * 
  * @return 0 on success, 1 on failure.
  */
 
 int WebServer::handleClientRequest(){
-    const int recvbuflen = 8192;
-    char recvbuf[recvbuflen];
-
-    int iResult = recv(clientSocket, recvbuf, recvbuflen, 0);
+    std::string request;
 
-    if( iResult == SOCKET_ERROR ){
-        std::cerr << "Recv failed: " << WSAGetLastError() << std::endl;
+    if( receiveRequestHeaders(request) == 1 ){
         closesocket(clientSocket);
         return 1;
     }
-    else if ( iResult == 0 ){
+    else if ( request.empty() ){
         closesocket(clientSocket);
         return 0;
     }
 
-    recvbuf[iResult] = '\0';
-    std::string request(recvbuf);
     // std::string method;
     // std::string route;
     // std::istringstream requestStream(request);
@@ -289,50 +392,53 @@ int WebServer::handleClientRequest(){
     std::string route = requestObject.getRequestRoute();
     std::string method = requestObject.getRequestType();
     // requestStream >> method >> route;
-    std::string response;
-    if(method == "GET"){
-        if(startsWith(route, cssDirectory)){
-            std::string cssFilePath = getRemainingPath(route, cssDirectory);
-            response = serveCSSFile(cssFilePath);
-        }
-        else if(startsWith(route, jsDirectory)){
-            std::string jsFilePath = getRemainingPath(route, jsDirectory);
-            response = serveJSFile(jsFilePath);
-        }
-        else if(startsWith(route, publicDirectory)){
-            std::string publicFilePath = getRemainingPath(route, publicDirectory);
-            response = servePublicFile(publicFilePath);
-        }
-        else{
-            response = searchGETTree(requestObject);
-        }
+    Response response;
+    if(!requestObject.contentLengthValid){
+        std::cerr<<method<<" "<<route<<": Invalid Content-Length"<<std::endl;
+        setErrorResponse(response, 400, R"({"error": "Bad Request"})");
     }
-    else if(method == "POST"){
-        response = searchPOSTTree(requestObject);
+    else if(requestObject.contentLength > maxBodySize){
+        // Rejected before anything of the body is read or 100 Continue is sent
+        std::cerr<<method<<" "<<route<<": Payload Too Large"<<std::endl;
+        setErrorResponse(response, 413, R"({"error": "Payload Too Large"})");
     }
-    else if(method == "PUT"){
-        response = searchPUTTree(requestObject);
-    }
-    else if(method == "PATCH"){
-        response = searchPATCHTree(requestObject);
+    else if(!requestObject.expectsContinue() && receiveRequestBody(requestObject) == 1){
+        closesocket(clientSocket);
+        return 0;
     }
-    else if(method == "DELETE"){
-        response = searchDELETETree(requestObject);
+    else if(method == "GET"){
+        const StaticMount* staticMount = findStaticMount(route);
+        if(staticMount){
+            staticMount->serve(route, requestObject, response);
+        }
+        else{
+            searchRouteTree(requestObject, response);
+            // Response functions may set validators, e.g. through render_template
+            if(response.httpStatusCode == 200 && requestObject.isNotModified(response.getHeader(HttpHeader::ETAG), response.getHeader(HttpHeader::LAST_MODIFIED))){
+                response.setNotModified();
+            }
+        }
     }
     else {
-        std::string rawResponse = R"({"error": "Method Not Allowed"})";
-        response = "HTTP/1.1 405 Method Not Allowed\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string(rawResponse.size()) + "\r\n\r\n" + rawResponse;
+        searchRouteTree(requestObject, response);
     }
 
-    iResult = send(clientSocket, response.c_str(), (int)response.length(), 0);
-    if (iResult == SOCKET_ERROR) {
-        std::cerr << "Send failed: " << WSAGetLastError() << std::endl;
-    }   
+    // The request was answered without reading its body, e.g. rejected by middleware after Expect: 100-continue
+    bool bodyUnread = !requestObject.bodyReceived && (!requestObject.contentLengthValid || requestObject.rawBody.size() < requestObject.contentLength);
+    if(bodyUnread){
+        response.setHeader(HttpHeader::CONNECTION, "close");
+    }
+
+    compressor.compress(requestObject, response);
+    sendResponse(response);
 
     iResult = shutdown(clientSocket, SD_SEND);
     if (iResult == SOCKET_ERROR) {
         std::cerr << "Shutdown failed: " << WSAGetLastError() << std::endl;
     }
+    else if(bodyUnread){
+        discardUnreadBody();
+    }
 
     closesocket(clientSocket);
 
@@ -344,11 +450,12 @@ int WebServer::handleClientRequest(){
  * 
  * This function associates a GET route with a response function and adds it to the server's route tree.
  * 
- * @param route The route path.
- * @param responseFunction A pointer to the response function to be called when the route is accessed.
+ * @param route The route path, or a glob or regex pattern (see RoutePattern).
+ * @param responseFunction The response function to be called when the route is accessed, a function or a lambda.
  */
-void WebServer::get(std::string route,  Response (*responseFunction)(Request&)){
-    GetRouteTree.insert(route, responseFunction);
+void WebServer::get(RoutePattern route, ResponseFunction responseFunction){
+    Middleware middleware;
+    router.addRoute(HTTP_GET, route, std::move(responseFunction), middleware);
 }
 
 /**
@@ -357,12 +464,12 @@ void WebServer::get(std::string route,  Response (*responseFunction)(Request&)){
  * This function associates a GET route with a response function and a middleware chain, then adds it to the server's route tree.
  * The middleware chain allows for additional processing of the request before the response function is called.
  * 
- * @param route The route path.
- * @param responseFunction A pointer to the response function to be called when the route is accessed.
+ * @param route The route path, or a glob or regex pattern (see RoutePattern).
+ * @param responseFunction The response function to be called when the route is accessed, a function or a lambda.
  * @param middleware A reference to the middleware chain to be executed before the response function.
  */
-void WebServer::get(std::string route,  Response (*responseFunction)(Request&), Middleware &middleware){
-    GetRouteTree.insert(route, responseFunction, middleware);
+void WebServer::get(RoutePattern route, ResponseFunction responseFunction, Middleware &middleware){
+    router.addRoute(HTTP_GET, route, std::move(responseFunction), middleware);
 }
 
 /**
@@ -370,11 +477,12 @@ void WebServer::get(std::string route,  Response (*responseFunction)(Request&),
  * 
  * This function associates a POST route with a response function and adds it to the server's route tree.
  * 
- * @param route The route path.
- * @param responseFunction A pointer to the response function to be called when the route is accessed.
+ * @param route The route path, or a glob or regex pattern (see RoutePattern).
+ * @param responseFunction The response function to be called when the route is accessed, a function or a lambda.
  */
-void WebServer::post(std::string route, Response (*responseFunction)(Request &)){
-    PostRouteTree.insert(route, responseFunction);
+void WebServer::post(RoutePattern route, ResponseFunction responseFunction){
+    Middleware middleware;
+    router.addRoute(HTTP_POST, route, std::move(responseFunction), middleware);
 }
 
 /**
@@ -383,12 +491,12 @@ void WebServer::post(std::string route, Response (*responseFunction)(Request &))
  * This function associates a POST route with a response function and a middleware chain, then adds it to the server's route tree.
  * The middleware chain allows for additional processing of the request before the response function is called.
  * 
- * @param route The route path.
- * @param responseFunction A pointer to the response function to be called when the route is accessed.
+ * @param route The route path, or a glob or regex pattern (see RoutePattern).
+ * @param responseFunction The response function to be called when the route is accessed, a function or a lambda.
  * @param middleware A reference to the middleware chain to be executed before the response function.
  */
-void WebServer::post(std::string route, Response (*responseFunction)(Request &), Middleware &middleware){
-    PostRouteTree.insert(route, responseFunction, middleware);
+void WebServer::post(RoutePattern route, ResponseFunction responseFunction, Middleware &middleware){
+    router.addRoute(HTTP_POST, route, std::move(responseFunction), middleware);
 }
 
 /**
@@ -396,11 +504,12 @@ void WebServer::post(std::string route, Response (*responseFunction)(Request &),
  * 
  * This function associates a PUT route with a response function and adds it to the server's route tree.
  * 
- * @param route The route path.
- * @param responseFunction A pointer to the response function to be called when the route is accessed.
+ * @param route The route path, or a glob or regex pattern (see RoutePattern).
+ * @param responseFunction The response function to be called when the route is accessed, a function or a lambda.
  */
-void WebServer::put(std::string route, Response (*responseFunction)(Request &)){
-    PutRouteTree.insert(route, responseFunction);
+void WebServer::put(RoutePattern route, ResponseFunction responseFunction){
+    Middleware middleware;
+    router.addRoute(HTTP_PUT, route, std::move(responseFunction), middleware);
 }
 
 /**
@@ -409,12 +518,12 @@ void WebServer::put(std::string route, Response (*responseFunction)(Request &)){
  * This function associates a PUT route with a response function and a middleware chain, then adds it to the server's route tree.
  * The middleware chain allows for additional processing of the request before the response function is called.
  * 
- * @param route The route path.
- * @param responseFunction A pointer to the response function to be called when the route is accessed.
+ * @param route The route path, or a glob or regex pattern (see RoutePattern).
+ * @param responseFunction The response function to be called when the route is accessed, a function or a lambda.
  * @param middleware A reference to the middleware chain to be executed before the response function.
  */
-void WebServer::put(std::string route, Response (*responseFunction)(Request &), Middleware &middleware){
-    PutRouteTree.insert(route, responseFunction, middleware);
+void WebServer::put(RoutePattern route, ResponseFunction responseFunction, Middleware &middleware){
+    router.addRoute(HTTP_PUT, route, std::move(responseFunction), middleware);
 }
 
 /**
@@ -422,11 +531,12 @@ void WebServer::put(std::string route, Response (*responseFunction)(Request &),
  * 
  * This function associates a PATCH route with a response function and adds it to the server's route tree.
  * 
- * @param route The route path.
- * @param responseFunction A pointer to the response function to be called when the route is accessed.
+ * @param route The route path, or a glob or regex pattern (see RoutePattern).
+ * @param responseFunction The response function to be called when the route is accessed, a function or a lambda.
  */
-void WebServer::patch(std::string route, Response (*responseFunction)(Request &)){
-    PatchRouteTree.insert(route, responseFunction);
+void WebServer::patch(RoutePattern route, ResponseFunction responseFunction){
+    Middleware middleware;
+    router.addRoute(HTTP_PATCH, route, std::move(responseFunction), middleware);
 }
 
 /**
@@ -435,12 +545,12 @@ void WebServer::patch(std::string route, Response (*responseFunction)(Request &)
  * This function associates a PATCH route with a response function and a middleware chain, then adds it to the server's route tree.
  * The middleware chain allows for additional processing of the request before the response function is called.
  * 
- * @param route The route path.
- * @param responseFunction A pointer to the response function to be called when the route is accessed.
+ * @param route The route path, or a glob or regex pattern (see RoutePattern).
+ * @param responseFunction The response function to be called when the route is accessed, a function or a lambda.
  * @param middleware A reference to the middleware chain to be executed before the response function.
  */
-void WebServer::patch(std::string route, Response (*responseFunction)(Request &), Middleware &middleware){
-    PatchRouteTree.insert(route, responseFunction, middleware);
+void WebServer::patch(RoutePattern route, ResponseFunction responseFunction, Middleware &middleware){
+    router.addRoute(HTTP_PATCH, route, std::move(responseFunction), middleware);
 }
 
 /**
@@ -448,11 +558,12 @@ void WebServer::patch(std::string route, Response (*responseFunction)(Request &)
  * 
  * This function associates a DELETE route with a response function and adds it to the server's route tree.
  * 
- * @param route The route path.
- * @param responseFunction A pointer to the response function to be called when the route is accessed.
+ * @param route The route path, or a glob or regex pattern (see RoutePattern).
+ * @param responseFunction The response function to be called when the route is accessed, a function or a lambda.
  */
-void WebServer::del(std::string route, Response (*responseFunction)(Request &)){
-    DeleteRouteTree.insert(route, responseFunction);
+void WebServer::del(RoutePattern route, ResponseFunction responseFunction){
+    Middleware middleware;
+    router.addRoute(HTTP_DELETE, route, std::move(responseFunction), middleware);
 }
 
 
@@ -462,201 +573,413 @@ void WebServer::del(std::string route, Response (*responseFunction)(Request &)){
  * This function associates a DELETE route with a response function and a middleware chain, then adds it to the server's route tree.
  * The middleware chain allows for additional processing of the request before the response function is called.
  * 
- * @param route The route path.
- * @param responseFunction A pointer to the response function to be called when the route is accessed.
+ * @param route The route path, or a glob or regex pattern (see RoutePattern).
+ * @param responseFunction The response function to be called when the route is accessed, a function or a lambda.
  * @param middleware A reference to the middleware chain to be executed before the response function.
  */
-void WebServer::del(std::string route, Response (*responseFunction)(Request &), Middleware &middleware){
-    DeleteRouteTree.insert(route, responseFunction, middleware);
+void WebServer::del(RoutePattern route, ResponseFunction responseFunction, Middleware &middleware){
+    router.addRoute(HTTP_DELETE, route, std::move(responseFunction), middleware);
 }
 
 /**
- * Search for a GET route in the route tree and return the corresponding response.
- * 
- * This function searches for the specified GET route in the route tree and returns the
- * corresponding response. If the route is not found, a 404 Not Found response is returned.
- * 
- * @param route The GET route to search for.
- * @return The HTTP response corresponding to the route, or a 404 Not Found response if the
- *         route is not found.
+ * Remove a route from the server.
+ *
+ * Like the functions that add routes, this can be called while the server is running, e.g. from a
+ * response function or another thread, to disable a feature route without a restart. Requests
+ * that are already being routed finish with the routes they started with.
+ *
+ * @param method The method the route was registered for.
+ * @param route The route path or pattern, exactly as it was registered.
+ * @return True if the route was removed, false if it was not registered.
  */
-std::string WebServer::searchGETTree(Request &requestObject) {
-    std::string route = requestObject.getRequestRoute();
-    Node* searchedRoute = GetRouteTree.search(requestObject);
-    std::string response;
-    if(searchedRoute == NULL){
-        std::cerr<<"GET "<<route<<": Not Found"<<std::endl;
-        std::string rawResponse = R"({"error": "Not Found"})";
-        return response = "HTTP/1.1 404 Not Found\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string(rawResponse.size()) + "\r\n\r\n" + rawResponse;
-    }
-    if(searchedRoute->containsResponseObject){
-        // Interrupted by a Middleware
-        return searchedRoute->response.getHttpResponse();
+bool WebServer::removeRoute(HttpMethod method, RoutePattern route){
+    return router.removeRoute(method, route);
+}
+
+/**
+ * Mount a route group on the server.
+ *
+ * All routes of the group and its subgroups are added below the group's prefix, and the group
+ * middleware runs before the middleware of each of its routes.
+ *
+ * @param group The group. It is copied, routes added to it afterwards are not served.
+ * @throw std::runtime_error if a route of the group is already defined or invalid.
+ */
+void WebServer::mount(const RouteGroup &group){
+    router.mount(group);
+}
+
+/**
+ * Add a global middleware function, which runs for every route of the server.
+ *
+ * Global middleware runs before the middleware of groups and routes, in the order it was added.
+ * It does not run for requests that match no route.
+ *
+ * @param middlewareFunction The middleware function, or a lambda or functor with the same signature.
+ */
+void WebServer::use(MiddlewareFunction middlewareFunction){
+    Middleware middleware;
+    middleware.push(std::move(middlewareFunction));
+    router.use(middleware);
+}
+
+/**
+ * Add global middleware, which runs for every route of the server.
+ *
+ * Its middleware functions run before those of groups and routes, its after hooks after theirs.
+ *
+ * @param middleware The middleware. It is copied, functions added to it afterwards do not run.
+ */
+void WebServer::use(Middleware &middleware){
+    router.use(middleware);
+}
+
+/**
+ * Set the maximum size of a request body.
+ *
+ * Requests whose Content-Length exceeds it are answered with 413 Payload Too Large before any of
+ * their body is read, and without sending `100 Continue`. The default is 1 MiB.
+ *
+ * @param maxBodySize The maximum body size in bytes.
+ */
+void WebServer::setMaxBodySize(std::size_t maxBodySize){
+    this->maxBodySize = maxBodySize;
+}
+
+/**
+ * Set the name sent in the `Server` header of every response.
+ *
+ * @param serverName The name, e.g. "CPP-Web-Server/2.0", or an empty string to send no `Server`
+ *        header. CR and LF are replaced by spaces.
+ */
+void WebServer::setServerName(const std::string &serverName){
+    if(serverName.empty()){
+        serverHeaderLine.clear();
+        return;
     }
-    Response responseObject = (searchedRoute->responseFunction)(requestObject);
-    response = responseObject.getHttpResponse();
-    std::cout<<"GET "<<route<<std::endl;
-    return response;
+    serverHeaderLine = "Server: " + serverName + "\r\n";
+    std::replace_if(serverHeaderLine.begin() + 8, serverHeaderLine.end() - 2, [](char c){ return c == '\r' || c == '\n'; }, ' ');
 }
 
 /**
- * Search for a POST route in the route tree and return the corresponding response.
- * 
- * This function searches for the specified POST route in the route tree and returns the
- * corresponding response. If the route is not found, a 404 Not Found response is returned.
- * 
- * @param route The POST route to search for.
- * @return The HTTP response corresponding to the route, or a 404 Not Found response if the
- *         route is not found.
+ * Search for the requested route in the route tree and set the corresponding response.
+ * 
+ * Routes registered with useStaticRoutes are looked up first, with a single probe of their perfect
+ * hash table, which yields their route in the current snapshot without searching it. Otherwise this
+ * function looks up the request path in the radix tree once for all methods. If the path is not
+ * found, a 404 Not Found response is returned. If the path is found but the request method is not
+ * registered for any route that matches it, a 405 Method Not Allowed response is returned, with
+ * an `Allow` header listing the methods of those routes. Otherwise the route's middleware chain
+ * and response function are executed.
+ * 
+ * @param requestObject The request to route.
+ * @param response The response to set.
  */
-std::string WebServer::searchPOSTTree(Request &requestObject){
+void WebServer::searchRouteTree(Request &requestObject, Response &response){
     std::string route = requestObject.getRequestRoute();
-    Node* searchedRoute = PostRouteTree.search(requestObject);
-    std::string response;
-    if(searchedRoute == NULL){
-        std::cerr<<"POST "<<route<<": Not Found"<<std::endl;
-        std::string rawResponse = R"({"error": "Not Found"})";
-        return response = "HTTP/1.1 404 Not Found\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string(rawResponse.size()) + "\r\n\r\n" + rawResponse;
-    }
-    if(searchedRoute->containsResponseObject){
+    std::string method = requestObject.getRequestType();
+    HttpMethod httpMethod = parseHttpMethod(method);
+
+    Router::ReadGuard routeTree(router);     // Keeps the route snapshot alive until the response is built
+    RouteMatch routeMatch;
+    if(staticRouteTable && httpMethod != HTTP_METHOD_COUNT){
+        routeMatch = routeTree->searchStatic(staticRouteLookup(staticRouteTable, httpMethod, route), httpMethod);
+    }
+    if(!routeMatch.found()){
+        routeMatch = routeTree->search(requestObject);
+    }
+    if(!routeMatch.found()){
+        std::cerr<<method<<" "<<route<<": Not Found"<<std::endl;
+        setErrorResponse(response, 404, R"({"error": "Not Found"})");
+        return;
+    }
+    if(!routeMatch.methodAllowed()){
+        std::cerr<<method<<" "<<route<<": Method Not Allowed"<<std::endl;
+        setErrorResponse(response, 405, R"({"error": "Method Not Allowed"})");
+        response.setHeader(HttpHeader::ALLOW, routeMatch.getAllowHeader());
+        return;
+    }
+    routeTree->executeMiddleware(routeMatch, requestObject);
+    if(routeMatch.interrupted()){
         // Interrupted by a Middleware
-        return searchedRoute->response.getHttpResponse();
+        response = std::move(*routeMatch.middlewareResponse);
+        return;
+    }
+    if(receiveRequestBody(requestObject) == 1){
+        setErrorResponse(response, 400, R"({"error": "Bad Request"})");
+        return;
     }
-    Response responseObject = (searchedRoute->responseFunction)(requestObject);
-    response = responseObject.getHttpResponse();
-    std::cout<<"POST "<<route<<std::endl;
-    return response;
+    response = (*routeMatch.responseFunction)(requestObject);
+    routeTree->executeAfterHooks(routeMatch, requestObject, response);
+    std::cout<<method<<" "<<route<<std::endl;
 }
 
 /**
- * Search for a PUT route in the route tree and return the corresponding response.
+ * Find the static mount that serves a route.
  * 
- * This function searches for the specified PUT route in the route tree and returns the
- * corresponding response. If the route is not found, a 404 Not Found response is returned.
- * 
- * @param route The PUT route to search for.
- * @return The HTTP response corresponding to the route, or a 404 Not Found response if the
- *         route is not found.
+ * @param route The request route.
+ * @return The mount with the longest URL prefix of the route, nullptr if no mount serves it.
  */
-std::string WebServer::searchPUTTree(Request &requestObject){
-    std::string route = requestObject.getRequestRoute();
-    Node* searchedRoute = PutRouteTree.search(requestObject);
-    std::string response;
-    if(searchedRoute == NULL){
-        std::cerr<<"PUT "<<route<<": Not Found"<<std::endl;
-        std::string rawResponse = R"({"error": "Page Not Found"})";
-        return response = "HTTP/1.1 404 Not Found\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string(rawResponse.size()) + "\r\n\r\n" + rawResponse;
-    }
-    if(searchedRoute->containsResponseObject){
-        // Interrupted by a Middleware
-        return searchedRoute->response.getHttpResponse();
+const StaticMount* WebServer::findStaticMount(const std::string &route) const{
+    const StaticMount* bestMount = nullptr;
+    for(const StaticMount& staticMount : staticMounts){
+        if(staticMount.matches(route) && (!bestMount || staticMount.getUrlPrefix().size() > bestMount->getUrlPrefix().size())){
+            bestMount = &staticMount;
+        }
     }
-    Response responseObject = (searchedRoute->responseFunction)(requestObject);
-    response = responseObject.getHttpResponse();
-    std::cout<<"PUT "<<route<<std::endl;
-    return response;
+    return bestMount;
 }
 
 /**
- * Search for a PATCH route in the route tree and return the corresponding response.
- * 
- * This function searches for the specified PATCH route in the route tree and returns the
- * corresponding response. If the route is not found, a 404 Not Found response is returned.
- * 
- * @param route The PATCH route to search for.
- * @return The HTTP response corresponding to the route, or a 404 Not Found response if the
- *         route is not found.
+ * Serve the files of a directory below a URL prefix.
+ * 
+ * GET requests below the prefix are answered with the directory's files before the routes are
+ * searched, see StaticMount. A mount with the same prefix is replaced, so the default mounts
+ * (`/static/css/`, `/static/js/` and `/public/`) can be reconfigured:
+ * @code
+ * server.mountStatic("/static/css/", "/static/css/", CachePolicy::maxAge(3600), true);
+ * server.mountStatic("/assets/", "/build/assets/", CachePolicy::noCache(), true);
+ * @endcode
+ * Mounts must be configured before the server runs.
+ * 
+ * @param urlPrefix The URL prefix, e.g. "/assets/".
+ * @param directory The directory relative to the working directory, e.g. "/build/assets/".
+ * @param cachePolicy The `Cache-Control` of the files.
+ * @param precompressed True to serve precompressed `.br` and `.gz` siblings of the files.
  */
-std::string WebServer::searchPATCHTree(Request &requestObject){
-    std::string route = requestObject.getRequestRoute();
-    Node* searchedRoute = PatchRouteTree.search(requestObject);
-    std::string response;
-    if(searchedRoute == NULL){
-        std::cerr<<"PATCH "<<route<<": Not Found"<<std::endl;
-        std::string rawResponse = R"({"error": "Page Not Found"})";
-        return response = "HTTP/1.1 404 Not Found\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string(rawResponse.size()) + "\r\n\r\n" + rawResponse;
-    }
-    if(searchedRoute->containsResponseObject){
-        // Interrupted by a Middleware
-        return searchedRoute->response.getHttpResponse();
+void WebServer::mountStatic(const std::string &urlPrefix, const std::string &directory, const CachePolicy &cachePolicy, bool precompressed){
+    StaticMount staticMount(urlPrefix, directory, cachePolicy, precompressed);
+    for(StaticMount& existingMount : staticMounts){
+        if(existingMount.getUrlPrefix() == staticMount.getUrlPrefix()){
+            existingMount = std::move(staticMount);
+            return;
+        }
     }
-    Response responseObject = (searchedRoute->responseFunction)(requestObject);
-    response = responseObject.getHttpResponse();
-    std::cout<<"PATCH "<<route<<std::endl;
-    return response;
+    staticMounts.push_back(std::move(staticMount));
 }
 
 /**
- * Search for a DELETE route in the route tree and return the corresponding response.
+ * Stop serving files below a URL prefix, e.g. one of the default mounts.
  * 
- * This function searches for the specified DELETE route in the route tree and returns the
- * corresponding response. If the route is not found, a 404 Not Found response is returned.
- * 
- * @param route The DELETE route to search for.
- * @return The HTTP response corresponding to the route, or a 404 Not Found response if the
- *         route is not found.
+ * @param urlPrefix The URL prefix of the mount.
+ * @return True if a mount was removed.
  */
-std::string WebServer::searchDELETETree(Request &requestObject){
-    std::string route = requestObject.getRequestRoute();
-    Node* searchedRoute = DeleteRouteTree.search(requestObject);
-    std::string response;
-    if(searchedRoute == NULL){
-        std::cerr<<"DELETE "<<route<<": Not Found"<<std::endl;
-        std::string rawResponse = R"({"error": "Page Not Found"})";
-        return response = "HTTP/1.1 404 Not Found\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string(rawResponse.size()) + "\r\n\r\n" + rawResponse;
-    }
-    if(searchedRoute->containsResponseObject){
-        // Interrupted by a Middleware
-        return searchedRoute->response.getHttpResponse();
+bool WebServer::unmountStatic(const std::string &urlPrefix){
+    std::string normalizedPrefix = StaticMount(urlPrefix, "/").getUrlPrefix();
+    for(auto it = staticMounts.begin(); it != staticMounts.end(); ++it){
+        if(it->getUrlPrefix() == normalizedPrefix){
+            staticMounts.erase(it);
+            return true;
+        }
     }
-    Response responseObject = (searchedRoute->responseFunction)(requestObject);
-    response = responseObject.getHttpResponse();
-    std::cout<<"DELETE "<<route<<std::endl;
-    return response;
+    return false;
 }
 
 /**
- * Serve a CSS file to the client.
- * 
- * This function serves the specified CSS file to the client by reading its contents and
- * generating an appropriate HTTP response.
- * 
- * @param cssFilePath The path to the CSS file.
- * @return The HTTP response containing the CSS file content.
+ * Map the route of a static file to its fingerprinted URL, for links in pages.
+ * 
+ * The URL carries a hash of the file's content, so it is served with
+ * `Cache-Control: public, max-age=31536000, immutable` and changes whenever the file does:
+ * @code
+ * std::string link = "<link rel=\"stylesheet\" href=\"" + server.assetUrl("/static/css/index.css") + "\">";
+ * @endcode
+ * The hash is computed once per version of the file.
+ * 
+ * @param route The route of the file, e.g. "/static/css/index.css".
+ * @return The fingerprinted URL, e.g. "/static/css/index.3f9a1c2b.css", or the route itself if no
+ *         mount serves it or the file does not exist.
  */
-std::string WebServer::serveCSSFile(std::string cssFilePath){
-    Response responseObject;
-    responseObject.serveFile(cssFilePath, cssDirectory);
-    return responseObject.getHttpResponse();
+std::string WebServer::assetUrl(const std::string &route) const{
+    const StaticMount* staticMount = findStaticMount(route);
+    if(!staticMount) return route;
+    return staticMount->assetUrl(route);
 }
 
 /**
- * Serve a JavaScript file to the client.
- * 
- * This function serves the specified JavaScript file to the client by reading its contents and
- * generating an appropriate HTTP response.
- * 
- * @param jsFilePath The path to the JavaScript file.
- * @return The HTTP response containing the JavaScript file content.
+ * Wrap a byte range in a Winsock buffer descriptor.
+ *
+ * @param bytes The bytes, which must stay alive until they are sent.
+ * @return The descriptor.
+ */
+static WSABUF makeBuffer(std::string_view bytes){
+    WSABUF buffer;
+    buffer.buf = const_cast<char*>(bytes.data());
+    buffer.len = static_cast<ULONG>(bytes.size());
+    return buffer;
+}
+
+/**
+ * Send the HTTP response to the client.
+ *
+ * The head is serialized into the output buffer, which keeps its capacity from previous requests.
+ * The `Date` and `Server` header lines are copied from their cached forms, the date is only
+ * formatted again when the second changed since the previous response.
+ * The body is then sent in the cheapest way for its kind:
+ *   - A string or shared buffer is sent from where it is, gathered with the head into a single
+ *     WSASend, so it is never copied into the output buffer.
+ *   - A file region is sent by TransmitFile, with the head as its head buffer. The file is read by
+ *     the kernel and never copied into user memory.
+ *   - A generator is pulled into a reused buffer and every piece is sent as one chunk, gathered
+ *     with its framing, or as it is if the length of the body is known. The head goes out with the
+ *     first piece.
+ * Redirects and responses whose status forbids a body (1xx, 204 and 304) are sent as the head
+ * alone, whatever content was set on them.
+ *
+ * @param response The response.
+ * @return 0 on success, 1 on failure.
  */
-std::string WebServer::serveJSFile(std::string jsFilePath){
-    Response responseObject;
-    responseObject.serveFile(jsFilePath, jsDirectory);
-    return responseObject.getHttpResponse();
+int WebServer::sendResponse(Response &response){
+    std::string& head = outputBuffer;
+    head.clear();
+    response.writeHttpHead(head, httpDate.getHeaderLine(), serverHeaderLine);
+
+    const ResponseBody& body = response.httpBody;
+    if(!response.redirectURL.empty() || !response.hasBody()){
+        // The head has no Content-Length, bytes after it would be taken for the next response
+        WSABUF buffers[1] = { makeBuffer(head) };
+        return sendBuffers(buffers, 1);
+    }
+    switch(body.getKind()){
+        case ResponseBody::FILE_REGION:
+            return sendFileRegion(head, body.getFileRegion());
+        case ResponseBody::GENERATOR:
+            return sendGeneratedBody(head, body.getGenerator(), !body.hasLength());
+        default: {
+            WSABUF buffers[2] = { makeBuffer(head), makeBuffer(body.getData()) };
+            return sendBuffers(buffers, 2);
+        }
+    }
 }
 
+/**
+ * Send several buffers to the client with as few calls as possible.
+ *
+ * WSASend may send only part of the buffers, the rest is sent by further calls.
+ *
+ * @param buffers The buffers, which are advanced past the bytes that were sent.
+ * @param bufferCount The number of buffers.
+ * @return 0 on success, 1 on failure.
+ */
+int WebServer::sendBuffers(WSABUF* buffers, DWORD bufferCount){
+    while(bufferCount > 0 && buffers->len == 0){
+        buffers++;
+        bufferCount--;
+    }
+    while(bufferCount > 0){
+        DWORD bytesSent = 0;
+        if(WSASend(clientSocket, buffers, bufferCount, &bytesSent, 0, NULL, NULL) == SOCKET_ERROR){
+            std::cerr << "Send failed: " << WSAGetLastError() << std::endl;
+            return 1;
+        }
+        while(bufferCount > 0 && bytesSent >= buffers->len){
+            bytesSent -= buffers->len;
+            buffers++;
+            bufferCount--;
+        }
+        if(bufferCount > 0){
+            buffers->buf += bytesSent;
+            buffers->len -= bytesSent;
+        }
+    }
+    return 0;
+}
 
 /**
- * Serve a public file to the client.
+ * Send the head and a region of a file to the client with TransmitFile.
+ *
+ * @param head The serialized status line and headers.
+ * @param fileRegion The region.
+ * @return 0 on success, 1 on failure.
+ */
+int WebServer::sendFileRegion(std::string_view head, const FileRegion &fileRegion){
+    if(fileRegion.getLength() == 0){
+        // TransmitFile would send the whole file for a length of 0
+        WSABUF buffers[1] = { makeBuffer(head) };
+        return sendBuffers(buffers, 1);
+    }
+    if(_lseeki64(fileRegion.getDescriptor(), static_cast<long long>(fileRegion.getOffset()), SEEK_SET) < 0){
+        std::cerr << "Seek failed for file descriptor " << fileRegion.getDescriptor() << std::endl;
+        return 1;
+    }
+    HANDLE file = reinterpret_cast<HANDLE>(_get_osfhandle(fileRegion.getDescriptor()));
+
+    TRANSMIT_FILE_BUFFERS headBuffer;
+    ZeroMemory(&headBuffer, sizeof(headBuffer));
+    headBuffer.Head = const_cast<char*>(head.data());
+    headBuffer.HeadLength = static_cast<DWORD>(head.size());
+
+    std::uint64_t remaining = fileRegion.getLength();
+    LPTRANSMIT_FILE_BUFFERS pendingHead = &headBuffer;
+    while(remaining > 0){
+        DWORD bytesToSend = static_cast<DWORD>(std::min(remaining, transmitFileChunkSize));
+        if(!TransmitFile(clientSocket, file, bytesToSend, 0, NULL, pendingHead, 0)){
+            std::cerr << "TransmitFile failed: " << WSAGetLastError() << std::endl;
+            return 1;
+        }
+        remaining -= bytesToSend;
+        pendingHead = NULL;
+    }
+    return 0;
+}
+
+/**
+ * Send the head and a generated body to the client, with chunked transfer encoding unless the
+ * head carries its `Content-Length`.
+ *
+ * Every call of the generator fills the reused generator buffer and becomes one chunk, sent with
+ * its size line and trailing CRLF in a single gathered WSASend. The head is gathered into the
+ * first send, the terminating zero-length chunk into the last. A body of known length is sent
+ * without this framing.
+ *
+ * @param head The serialized status line and headers.
+ * @param generator The generator.
+ * @param chunked Whether to send the body with chunked transfer encoding.
+ * @return 0 on success, 1 on failure.
+ */
+int WebServer::sendGeneratedBody(std::string_view head, BodyGenerator &generator, bool chunked){
+    generatorBuffer.resize(generatorChunkSize);
+    std::string_view pendingHead = head;
+    for(;;){
+        std::size_t chunkLength = generator(&generatorBuffer[0], generatorChunkSize);
+        if(chunkLength == 0) break;
+        if(chunkLength > generatorChunkSize) chunkLength = generatorChunkSize;
+        if(!chunked){
+            WSABUF buffers[2] = { makeBuffer(pendingHead), makeBuffer(std::string_view(generatorBuffer.data(), chunkLength)) };
+            if(sendBuffers(buffers, 2) == 1) return 1;
+            pendingHead = std::string_view();
+            continue;
+        }
+
+        char sizeLine[20];
+        std::to_chars_result sizeEnd = std::to_chars(sizeLine, sizeLine + sizeof(sizeLine) - 2, chunkLength, 16);
+        *sizeEnd.ptr++ = '\r';
+        *sizeEnd.ptr++ = '\n';
+        WSABUF buffers[4] = {
+            makeBuffer(pendingHead),
+            makeBuffer(std::string_view(sizeLine, sizeEnd.ptr - sizeLine)),
+            makeBuffer(std::string_view(generatorBuffer.data(), chunkLength)),
+            makeBuffer("\r\n")
+        };
+        if(sendBuffers(buffers, 4) == 1) return 1;
+        pendingHead = std::string_view();
+    }
+    WSABUF buffers[2] = { makeBuffer(pendingHead), makeBuffer(chunked ? "0\r\n\r\n" : "") };
+    return sendBuffers(buffers, 2);
+}
+
+/**
+ * Add a route of a static route table to the radix tree.
  * 
- * This function serves the specified file from the public directory to the client by reading its
- * contents and generating an appropriate HTTP response.
+ * The static route table only finds these routes, they are served from the radix tree like any other
+ * route, with its middleware chains, and can be removed with removeRoute.
  * 
- * @param publicFilePath The path to the public file.
- * @return The HTTP response containing the public file content.
+ * @param staticRoute The route.
  */
-std::string WebServer::servePublicFile(std::string publicFilePath){
-    Response responseObject;
-    responseObject.serveFile(publicFilePath, publicDirectory);
-    return responseObject.getHttpResponse();
+void WebServer::addStaticRoute(const StaticRoute &staticRoute){
+    std::string route(staticRoute.route);
+    if(route.find("/:") != std::string::npos || route.find("/*") != std::string::npos){
+        throw std::runtime_error("Static routes cannot contain parameters or wildcards: " + route);
+    }
+    Middleware middleware;
+    router.addRoute(staticRoute.method, route, staticRoute.responseFunction, middleware);
 }
\ No newline at end of file
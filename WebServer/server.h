@@ -3,10 +3,18 @@
 #include <winsock2.h>
 #include <ws2tcpip.h>
 #include <string>
+#include <string_view>
 
-#include "avltree.h"
+#include "router.h"
+#include "staticroutetable.h"
 #include "response.h"
 #include "middleware.h"
+#include "httpdate.h"
+#include "responsecompressor.h"
+#include "staticmount.h"
+#include "jsonwriter.h"
+#include "cachepolicy.h"
+#include <vector>
 
 /**
  * @brief A simple HTTP web server implemented in C++ using Winsock2 by Tirthraj Mahajan.
@@ -16,8 +24,9 @@
  * requests, and serves static files and dynamic content based on the requested routes.
  * 
  * The server supports GET requests for serving static files such as CSS, JavaScript, and
- * other resources stored in predefined directories. Additionally, it allows users to register
- * custom response functions for specific routes, enabling dynamic content generation.
+ * other resources from directories mounted below URL prefixes, see mountStatic. Additionally,
+ * it allows users to register custom response functions for specific routes, enabling dynamic
+ * content generation.
  * 
  * @note This class requires Windows operating system and Winsock2 library for networking.
  */
@@ -36,16 +45,23 @@ private:
     const char* PORT;           ///< Port number for the server
 
     SOCKET clientSocket;    ///< Socket for communicating with client
+    std::string outputBuffer;   ///< The serialized status line and headers sent to the client, reused for every request
+    std::string generatorBuffer;    ///< The buffer a BodyGenerator fills with each chunk, reused for every request
+    HttpDate httpDate;              ///< The `Date` header line, reformatted at most once per second
+    ResponseCompressor compressor;  ///< Compresses response bodies, its encoder state is reused for every request
+    std::string serverHeaderLine = "Server: CPP-Web-Server\r\n";     ///< The `Server` header line, empty to send none
+    std::size_t maxBodySize = 1024 * 1024;  ///< The largest Content-Length accepted, see setMaxBodySize
 
-    AVLTree GetRouteTree;   ///< AVL tree to store GET routes and associated response functions
-    AVLTree PostRouteTree;   ///< AVL tree to store POST routes and associated response functions
-    AVLTree PutRouteTree;   ///< AVL tree to store PUT routes and associated response functions
-    AVLTree PatchRouteTree;    ///< AVL tree to store PATCH routes and associated response functions
-    AVLTree DeleteRouteTree;   ///< AVL tree to store DELETE routes and associated response functions
+    Router router;          ///< The routes and their response functions for all methods, changeable while the server runs
 
-    std::string cssDirectory = "/static/css/";      ///< Directory for serving CSS files
-    std::string jsDirectory = "/static/js/";        ///< Directory for serving JavaScript files
-    std::string publicDirectory = "/public/";       ///< Directory for serving other public files
+    const void* staticRouteTable = nullptr;    ///< The compile-time route table registered with useStaticRoutes, if any
+    std::size_t (*staticRouteLookup)(const void* table, HttpMethod method, std::string_view route) = nullptr;  ///< Calls indexOf() on staticRouteTable
+
+    std::vector<StaticMount> staticMounts = {       ///< The directories served below URL prefixes, see mountStatic
+        StaticMount("/static/css/", "/static/css/", CachePolicy::noCache(), true),
+        StaticMount("/static/js/", "/static/js/", CachePolicy::noCache(), true),
+        StaticMount("/public/", "/public/", CachePolicy::noCache())
+    };
 
     int initializeWinsock(); 
     int createUnboundedSocket();
@@ -54,33 +70,72 @@ private:
     int listenForConnections();
     int acceptConnectionRequest();
     int handleClientRequest();
-    std::string searchGETTree(Request& requestObject);
-    std::string searchPOSTTree(Request& requestObject);
-    std::string searchPUTTree(Request& requestObject);
-    std::string searchPATCHTree(Request& requestObject);
-    std::string searchDELETETree(Request& requestObject);
-
-    bool startsWith(const std::string& str, const std::string& prefix);
-    std::string getRemainingPath(const std::string& str, const std::string& prefix);
-    std::string serveCSSFile(std::string cssFilePath);
-    std::string serveJSFile(std::string jsFilePath);
-    std::string servePublicFile(std::string publicFilePath);
+    int receiveRequestHeaders(std::string& rawRequest);
+    int receiveRequestBody(Request& requestObject);
+    void discardUnreadBody();
+    void searchRouteTree(Request& requestObject, Response& response);
+    int sendResponse(Response& response);
+    int sendBuffers(WSABUF* buffers, DWORD bufferCount);
+    int sendFileRegion(std::string_view head, const FileRegion& fileRegion);
+    int sendGeneratedBody(std::string_view head, BodyGenerator& generator, bool chunked);
+    void addStaticRoute(const StaticRoute& staticRoute);
+
+    const StaticMount* findStaticMount(const std::string& route) const;
 
 public:
     WebServer(const char* PORT,const char* IPAddr);
     ~WebServer();
 
     int run();
-    void get(std::string route, Response (*responseFunction)(Request&));
-    void get(std::string route, Response (*responseFunction)(Request &), Middleware &middleware);
-    void post(std::string route, Response (*responseFunction)(Request&));
-    void post(std::string route, Response (*responseFunction)(Request &), Middleware &middleware);
-    void put(std::string route, Response (*responseFunction)(Request&));
-    void put(std::string route, Response (*responseFunction)(Request &), Middleware &middleware);
-    void patch(std::string route, Response (*responseFunction)(Request&));
-    void patch(std::string route, Response (*responseFunction)(Request &), Middleware &middleware);
-    void del(std::string route, Response (*responseFunction)(Request&));
-    void del(std::string route, Response (*responseFunction)(Request &), Middleware &middleware);
+    void get(RoutePattern route, ResponseFunction responseFunction);
+    void get(RoutePattern route, ResponseFunction responseFunction, Middleware &middleware);
+    void post(RoutePattern route, ResponseFunction responseFunction);
+    void post(RoutePattern route, ResponseFunction responseFunction, Middleware &middleware);
+    void put(RoutePattern route, ResponseFunction responseFunction);
+    void put(RoutePattern route, ResponseFunction responseFunction, Middleware &middleware);
+    void patch(RoutePattern route, ResponseFunction responseFunction);
+    void patch(RoutePattern route, ResponseFunction responseFunction, Middleware &middleware);
+    void del(RoutePattern route, ResponseFunction responseFunction);
+    void del(RoutePattern route, ResponseFunction responseFunction, Middleware &middleware);
+    bool removeRoute(HttpMethod method, RoutePattern route);
+    void mount(const RouteGroup& group);
+    void use(MiddlewareFunction middlewareFunction);
+    void use(Middleware &middleware);
+    void setServerName(const std::string& serverName);
+    void setMaxBodySize(std::size_t maxBodySize);
+    void mountStatic(const std::string& urlPrefix, const std::string& directory, const CachePolicy& cachePolicy = CachePolicy(), bool precompressed = false);
+    bool unmountStatic(const std::string& urlPrefix);
+    std::string assetUrl(const std::string& route) const;
+
+    /**
+     * Register a compile-time table of exact-match routes.
+     * 
+     * Requests for these routes are looked up through the table's perfect hash instead of
+     * searching the radix tree. The routes are also added to the radix tree, so that requests with
+     * a different method are answered with 405 and a complete Allow header, and the table only
+     * replaces the lookup: static routes run the global middleware (see use()), the middleware of
+     * groups mounted above them and all after hooks like any other route, and a static route
+     * removed with removeRoute() is no longer served. The table must outlive the server, typically
+     * it is a `constexpr` variable.
+     * 
+     * @param table The table, built with makeStaticRouteTable.
+     * @throw std::runtime_error if a table is already registered, or if a route is already defined
+     *        or contains a `:param` or `*wildcard` segment.
+     */
+    template <std::size_t N>
+    void useStaticRoutes(const StaticRouteTable<N>& table){
+        if(staticRouteTable){
+            throw std::runtime_error("A static route table is already registered");
+        }
+        for(const StaticRoute& staticRoute : table){
+            addStaticRoute(staticRoute);
+        }
+        router.setStaticRoutes(std::vector<StaticRoute>(table.begin(), table.end()));
+        staticRouteTable = &table;
+        staticRouteLookup = [](const void* registeredTable, HttpMethod method, std::string_view route){
+            return static_cast<const StaticRouteTable<N>*>(registeredTable)->indexOf(method, route);
+        };
+    }
 
 };
 
@@ -0,0 +1,143 @@
+#include "staticmount.h"
+#include "validatorcache.h"
+
+/**
+ * @brief Adds the leading and trailing '/' of a prefix if they are missing.
+ */
+static std::string normalizePrefix(const std::string &prefix){
+    std::string normalized = prefix;
+    if(normalized.empty() || normalized.front() != '/') normalized.insert(normalized.begin(), '/');
+    if(normalized.back() != '/') normalized.push_back('/');
+    return normalized;
+}
+
+/**
+ * @brief Checks that a path below a mount stays inside its directory.
+ *
+ * @param filePath The path below the mount, as taken from the request route.
+ * @return False if a segment is "." or "..", or the path contains a backslash, which Windows also
+ *         takes as a separator.
+ */
+static bool isSafeFilePath(std::string_view filePath){
+    if(filePath.find('\\') != std::string_view::npos) return false;
+    for(;;){
+        std::size_t segmentEnd = filePath.find('/');
+        std::string_view segment = filePath.substr(0, segmentEnd);
+        if(segment == "." || segment == "..") return false;
+        if(segmentEnd == std::string_view::npos) return true;
+        filePath.remove_prefix(segmentEnd + 1);
+    }
+}
+
+/**
+ * @brief Creates a mount.
+ *
+ * @param urlPrefix The URL prefix of the files, e.g. "/static/css/".
+ * @param directory The directory of the files relative to the working directory, e.g. "/static/css/".
+ * @param cachePolicy The `Cache-Control` of the files, by default none.
+ * @param precompressed True to serve precompressed `.br` and `.gz` siblings of the files.
+ */
+StaticMount::StaticMount(const std::string &urlPrefix, const std::string &directory, const CachePolicy &cachePolicy, bool precompressed)
+    : urlPrefix(normalizePrefix(urlPrefix)),
+      directory(normalizePrefix(directory)),
+      cachePolicy(cachePolicy),
+      precompressed(precompressed)
+{
+}
+
+/**
+ * @brief Checks whether a request route lies below the mount's URL prefix.
+ */
+bool StaticMount::matches(std::string_view route) const{
+    return route.size() >= urlPrefix.size() && route.compare(0, urlPrefix.size(), urlPrefix) == 0;
+}
+
+/**
+ * @brief Splits a fingerprinted file name, e.g. "css/index.3f9a1c2b.css", into "css/index.css" and "3f9a1c2b".
+ *
+ * @param filePath The path below the mount.
+ * @param logicalPath Set to the path without the fingerprint.
+ * @param fingerprint Set to the fingerprint, a view into filePath.
+ * @return False if the file name carries no fingerprint.
+ */
+bool StaticMount::splitFingerprint(const std::string &filePath, std::string &logicalPath, std::string_view &fingerprint){
+    std::size_t nameStart = filePath.find_last_of('/') + 1;     // npos + 1 is 0
+    std::size_t extensionStart = filePath.find_last_of('.');
+    if(extensionStart == std::string::npos || extensionStart < nameStart) return false;
+
+    // The fingerprint is either the last dot-separated part before the extension or, for a file without an extension, the extension itself
+    std::size_t fingerprintStart = extensionStart + 1;
+    std::size_t fingerprintEnd = filePath.size();
+    if(filePath.size() - fingerprintStart != fingerprintLength){
+        std::size_t previousDot = filePath.find_last_of('.', extensionStart - 1);
+        if(extensionStart == 0 || previousDot == std::string::npos || previousDot < nameStart) return false;
+        fingerprintStart = previousDot + 1;
+        fingerprintEnd = extensionStart;
+    }
+    if(fingerprintEnd - fingerprintStart != fingerprintLength) return false;
+    for(std::size_t i = fingerprintStart; i < fingerprintEnd; i++){
+        char c = filePath[i];
+        if(!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) return false;
+    }
+    fingerprint = std::string_view(filePath).substr(fingerprintStart, fingerprintLength);
+    logicalPath = filePath.substr(0, fingerprintStart - 1) + filePath.substr(fingerprintEnd);
+    return true;
+}
+
+/**
+ * @brief Answers a GET request for a file of the mount.
+ *
+ * A file name with a fingerprint is served as the file without it, with CachePolicy::immutable()
+ * if the fingerprint matches the file's current content. A file whose actual name looks
+ * fingerprinted is served as it is. A path with a "." or ".." segment or a backslash is answered
+ * with 404, it could name a file outside the mount's directory.
+ *
+ * @param route The request route, which must match the mount.
+ * @param request The request.
+ * @param response The response to set.
+ */
+void StaticMount::serve(const std::string &route, const Request &request, Response &response) const{
+    std::string filePath = route.substr(urlPrefix.size());
+    if(!isSafeFilePath(filePath)){
+        response.setStatusCode(404);
+        response.setContentType("text/plain");
+        response.setContent("File not found");
+        return;
+    }
+    const CachePolicy* policy = &cachePolicy;
+
+    std::string logicalPath;
+    std::string_view fingerprint;
+    if(splitFingerprint(filePath, logicalPath, fingerprint)){
+        ValidatorCache& validatorCache = ValidatorCache::global();
+        if(!validatorCache.lookup("." + directory + filePath)){
+            std::shared_ptr<const ValidatorCache::CachedFile> cachedFile = validatorCache.lookup("." + directory + logicalPath, ValidatorCache::LOAD_FINGERPRINT);
+            static const CachePolicy immutablePolicy = CachePolicy::immutable();
+            if(cachedFile && cachedFile->fingerprint == fingerprint) policy = &immutablePolicy;
+            filePath = std::move(logicalPath);
+        }
+    }
+
+    response.serveFile(filePath, directory, request, precompressed);
+    int statusCode = response.httpStatusCode;
+    if(statusCode == 200 || statusCode == 206 || statusCode == 304) policy->apply(response);
+}
+
+/**
+ * @brief Maps the route of a file to its fingerprinted URL.
+ *
+ * @param route The route of the file, which must match the mount, e.g. "/static/css/index.css".
+ * @return The fingerprinted URL, e.g. "/static/css/index.3f9a1c2b.css". The route itself if the file does not exist
+ *         or the route leaves the mount's directory, see serve.
+ */
+std::string StaticMount::assetUrl(const std::string &route) const{
+    std::string filePath = route.substr(urlPrefix.size());
+    if(!isSafeFilePath(filePath)) return route;
+    std::shared_ptr<const ValidatorCache::CachedFile> cachedFile = ValidatorCache::global().lookup("." + directory + filePath, ValidatorCache::LOAD_FINGERPRINT);
+    if(!cachedFile) return route;
+
+    std::size_t nameStart = route.find_last_of('/') + 1;
+    std::size_t extensionStart = route.find_last_of('.');
+    if(extensionStart == std::string::npos || extensionStart <= nameStart) extensionStart = route.size();
+    return route.substr(0, extensionStart) + "." + cachedFile->fingerprint + route.substr(extensionStart);
+}
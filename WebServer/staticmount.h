@@ -0,0 +1,45 @@
+#ifndef STATICMOUNT_H
+#define STATICMOUNT_H
+#include <string>
+#include <string_view>
+#include "cachepolicy.h"
+#include "request.h"
+#include "response.h"
+
+/**
+ * @brief A directory whose files are served below a URL prefix, with a cache policy.
+ *
+ * A GET request for `urlPrefix + path` is answered with the file `"." + directory + path`, see
+ * Response::serveFile: with validators and 304 Not Modified, byte ranges and, if precompressed is
+ * set, precompressed `.br` and `.gz` siblings. The mount's CachePolicy sets `Cache-Control`.
+ *
+ * Files can also be requested through a fingerprinted URL, which carries a hash of the file's
+ * content before the extension, e.g. `/static/css/index.3f9a1c2b.css` for `index.css`. Such a URL
+ * names one version of the file, so it is served with CachePolicy::immutable() and clients never
+ * revalidate it. After a deploy the page links to the new fingerprint, see assetUrl. A URL whose
+ * fingerprint no longer matches is answered with the current file and the mount's own policy.
+ */
+class StaticMount{
+private:
+    std::string urlPrefix;          ///< Starts and ends with '/', e.g. "/static/css/"
+    std::string directory;          ///< Relative to the working directory, starts and ends with '/'
+    CachePolicy cachePolicy;
+    bool precompressed = false;     ///< Whether to look for precompressed siblings
+
+    static bool splitFingerprint(const std::string& filePath, std::string& logicalPath, std::string_view& fingerprint);
+
+public:
+    static const std::size_t fingerprintLength = 8;     ///< The hex digits of the content hash in a fingerprinted URL
+
+    StaticMount(const std::string& urlPrefix, const std::string& directory, const CachePolicy& cachePolicy = CachePolicy(), bool precompressed = false);
+
+    bool matches(std::string_view route) const;
+    void serve(const std::string& route, const Request& request, Response& response) const;
+    std::string assetUrl(const std::string& route) const;
+
+    const std::string& getUrlPrefix() const { return urlPrefix; }
+    const std::string& getDirectory() const { return directory; }
+    const CachePolicy& getCachePolicy() const { return cachePolicy; }
+};
+
+#endif
@@ -0,0 +1,209 @@
+#ifndef STATICROUTETABLE_H
+#define STATICROUTETABLE_H
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include "httpmethod.h"
+#include "response.h"
+#include "request.h"
+
+/**
+ * @brief An exact-match route known at compile time.
+ *
+ * Used to build a StaticRouteTable, e.g. `StaticRoute{HTTP_GET, "/about", &AboutPage}`.
+ */
+struct StaticRoute {
+    HttpMethod method;
+    std::string_view route;
+    Response (*responseFunction)(Request&);
+};
+
+/**
+ * @brief A perfect hash table of exact-match routes, built at compile time.
+ *
+ * The table uses hash-and-displace: every route's 64-bit hash selects a bucket, and every bucket
+ * stores a seed that was chosen, while building, so that all routes of all buckets land in distinct
+ * slots. A lookup therefore costs one hash of the route, one remix with the bucket's seed and one
+ * compare, independent of the number of routes.
+ *
+ * Routes are plain strings: `:param` and `*wildcard` segments are not supported, those routes
+ * belong in the server's radix tree. The table only replaces the lookup: the server still runs the
+ * global middleware and after hooks of a static route, and a removed route is no longer served.
+ *
+ * The constructor is constexpr, so a table declared `constexpr` is built entirely by the compiler:
+ * @code
+ * constexpr auto staticRoutes = makeStaticRouteTable(
+ *     StaticRoute{HTTP_GET, "/", &HomePage},
+ *     StaticRoute{HTTP_GET, "/about", &AboutPage});
+ * server.useStaticRoutes(staticRoutes);
+ * @endcode
+ *
+ * @tparam N The number of routes.
+ */
+template <std::size_t N>
+class StaticRouteTable{
+public:
+    static constexpr std::size_t tableSizeFor(std::size_t routeCount){
+        std::size_t size = 1;
+        while(size < 2 * routeCount) size *= 2;
+        return size;
+    }
+
+    static constexpr std::size_t bucketCount = N / 4 + 1;          ///< About four routes share a bucket
+    static constexpr std::size_t tableSize = tableSizeFor(N);      ///< Power of two with room for twice the routes
+
+private:
+    struct Slot {
+        std::uint64_t hash = 0;
+        StaticRoute route = {HTTP_METHOD_COUNT, std::string_view(), nullptr};
+        std::size_t index = N;     ///< Position of the route in the table's routes
+    };
+
+    std::array<StaticRoute, N> routes;
+    std::array<Slot, tableSize> slots;
+    std::array<std::uint64_t, bucketCount> seeds;
+
+    static constexpr std::uint64_t hashRoute(HttpMethod method, std::string_view route){
+        std::uint64_t hash = 14695981039346656037ull;     // FNV-1a
+        for(char c : route){
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        hash ^= static_cast<std::uint64_t>(method) + 1;
+        hash *= 1099511628211ull;
+        return hash;
+    }
+
+    static constexpr std::size_t slotIndex(std::uint64_t hash, std::uint64_t seed){
+        std::uint64_t mixed = hash ^ (seed * 0x9E3779B97F4A7C15ull);     // splitmix64 finalizer
+        mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+        mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBull;
+        mixed ^= mixed >> 31;
+        return static_cast<std::size_t>(mixed & (tableSize - 1));
+    }
+
+    static constexpr std::size_t bucketIndex(std::uint64_t hash){
+        return static_cast<std::size_t>((hash >> 32) % bucketCount);
+    }
+
+    /**
+     * @brief Tries to place the routes of a bucket with a seed, used while building the table.
+     *
+     * @param routeHashes The hash of every route.
+     * @param bucketStart The first position of every bucket in bucketMembers, followed by N.
+     * @param bucketMembers The indices of the routes, grouped by bucket.
+     * @return True if all routes of the bucket landed in distinct free slots and were placed.
+     */
+    constexpr bool tryPlaceBucket(std::size_t bucket, std::uint64_t seed, const std::array<std::uint64_t, N>& routeHashes,
+                                  const std::array<std::size_t, bucketCount + 1>& bucketStart, const std::array<std::size_t, N>& bucketMembers){
+        for(std::size_t i = bucketStart[bucket]; i < bucketStart[bucket + 1]; i++){
+            std::size_t slot = slotIndex(routeHashes[bucketMembers[i]], seed);
+            if(slots[slot].route.responseFunction != nullptr) return false;
+            for(std::size_t j = bucketStart[bucket]; j < i; j++){
+                if(slotIndex(routeHashes[bucketMembers[j]], seed) == slot) return false;
+            }
+        }
+        for(std::size_t i = bucketStart[bucket]; i < bucketStart[bucket + 1]; i++){
+            std::size_t slot = slotIndex(routeHashes[bucketMembers[i]], seed);
+            slots[slot].hash = routeHashes[bucketMembers[i]];
+            slots[slot].route = routes[bucketMembers[i]];
+            slots[slot].index = bucketMembers[i];
+        }
+        seeds[bucket] = seed;
+        return true;
+    }
+
+public:
+    /**
+     * @brief Builds the table.
+     *
+     * The hashes and bucket lists needed while building are locals of the constructor, so the
+     * table only keeps its routes, slots and seeds. Built at runtime, it needs about 24 bytes of
+     * stack per route for them.
+     *
+     * @param routes The routes. Every method and route pair must be unique and every response function non-null.
+     * @throw std::runtime_error if a route is defined twice. In a constant expression this is a compile error instead.
+     */
+    constexpr explicit StaticRouteTable(const std::array<StaticRoute, N>& routes)
+        : routes(routes), slots(), seeds() {
+        std::array<std::uint64_t, N> routeHashes{};
+        std::array<std::size_t, bucketCount + 1> bucketStart{};
+        std::array<std::size_t, N> bucketMembers{};
+        for(std::size_t i = 0; i < N; i++){
+            if(routes[i].responseFunction == nullptr){
+                throw std::runtime_error("Static route without a response function");
+            }
+            routeHashes[i] = hashRoute(routes[i].method, routes[i].route);
+            bucketStart[bucketIndex(routeHashes[i])]++;
+        }
+
+        // Group the routes by bucket: bucketMembers[bucketStart[b] .. bucketStart[b + 1]) belong to bucket b
+        std::size_t largestBucket = 0;
+        std::size_t bucketEnd = 0;
+        for(std::size_t bucket = 0; bucket < bucketCount; bucket++){
+            if(bucketStart[bucket] > largestBucket) largestBucket = bucketStart[bucket];
+            bucketEnd += bucketStart[bucket];
+            bucketStart[bucket] = bucketEnd;
+        }
+        bucketStart[bucketCount] = N;
+        for(std::size_t i = 0; i < N; i++){
+            bucketMembers[--bucketStart[bucketIndex(routeHashes[i])]] = i;
+        }
+
+        for(std::size_t bucket = 0; bucket < bucketCount; bucket++){
+            for(std::size_t i = bucketStart[bucket]; i < bucketStart[bucket + 1]; i++){
+                for(std::size_t j = bucketStart[bucket]; j < i; j++){
+                    const StaticRoute& a = routes[bucketMembers[i]];
+                    const StaticRoute& b = routes[bucketMembers[j]];
+                    if(a.method == b.method && a.route == b.route){
+                        throw std::runtime_error("Two definitions for the same static route");
+                    }
+                }
+            }
+        }
+
+        // Place the largest buckets first, while the table is still empty
+        for(std::size_t size = largestBucket; size > 0; size--){
+            for(std::size_t bucket = 0; bucket < bucketCount; bucket++){
+                if(bucketStart[bucket + 1] - bucketStart[bucket] != size) continue;
+                std::uint64_t seed = 0;
+                while(!tryPlaceBucket(bucket, seed, routeHashes, bucketStart, bucketMembers)) seed++;
+            }
+        }
+    }
+
+    /**
+     * @brief Looks up the position of a route in the table.
+     *
+     * @param method The request method.
+     * @param route The request path, without the query string.
+     * @return The index of the route in iteration order, or `size()` if the table has no such route.
+     */
+    constexpr std::size_t indexOf(HttpMethod method, std::string_view route) const{
+        std::uint64_t hash = hashRoute(method, route);
+        const Slot& slot = slots[slotIndex(hash, seeds[bucketIndex(hash)])];
+        if(slot.hash == hash && slot.route.method == method && slot.route.route == route){
+            return slot.index;
+        }
+        return N;
+    }
+
+    constexpr std::size_t size() const { return N; }
+    constexpr const StaticRoute* begin() const { return routes.data(); }
+    constexpr const StaticRoute* end() const { return routes.data() + N; }
+};
+
+/**
+ * @brief Builds a StaticRouteTable from a list of routes.
+ *
+ * @param routes The routes, each a StaticRoute.
+ * @return The table, constexpr if the arguments are constant expressions.
+ */
+template <typename... Routes>
+constexpr StaticRouteTable<sizeof...(Routes)> makeStaticRouteTable(const Routes&... routes){
+    return StaticRouteTable<sizeof...(Routes)>(std::array<StaticRoute, sizeof...(Routes)>{routes...});
+}
+
+#endif
@@ -0,0 +1,154 @@
+#include "validatorcache.h"
+#include "httpdate.h"
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Gets the cache shared by all servers of the process.
+ */
+ValidatorCache& ValidatorCache::global(){
+    static ValidatorCache cache;
+    return cache;
+}
+
+/**
+ * @brief Builds the validators of a file version.
+ *
+ * @param size The size of the file in bytes.
+ * @param modifiedTime The modification time of the file.
+ * @return The validators, without content.
+ */
+static std::shared_ptr<ValidatorCache::CachedFile> makeCachedFile(std::uint64_t size, std::time_t modifiedTime){
+    std::shared_ptr<ValidatorCache::CachedFile> file = std::make_shared<ValidatorCache::CachedFile>();
+    file->size = size;
+    file->modifiedTime = modifiedTime;
+
+    char etag[40];
+    char* position = etag;
+    *position++ = '"';
+    position = std::to_chars(position, etag + sizeof(etag), size, 16).ptr;
+    *position++ = '-';
+    position = std::to_chars(position, etag + sizeof(etag), static_cast<std::int64_t>(modifiedTime), 16).ptr;
+    *position++ = '"';
+    file->etag.assign(etag, position);
+
+    char lastModified[HttpDate::formattedLength];
+    HttpDate::format(modifiedTime, lastModified);
+    file->lastModified.assign(lastModified, sizeof(lastModified));
+    return file;
+}
+
+/**
+ * @brief Gets the validators of a file.
+ *
+ * @param filePath The path of the file.
+ * @param loadFlags LOAD_CONTENT to also load the file into memory, LOAD_FINGERPRINT to hash its content.
+ *                  Either is done again only when the file changes.
+ * @return The cached file, nullptr if it does not exist or is not a regular file.
+ */
+std::shared_ptr<const ValidatorCache::CachedFile> ValidatorCache::lookup(const std::string &filePath, int loadFlags){
+    std::time_t now = std::time(nullptr);
+    std::shared_ptr<const CachedFile> cachedFile;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto entry = entries.find(filePath);
+        if(entry != entries.end()){
+            cachedFile = entry->second.file;
+            bool fresh = now - entry->second.checkedAt < recheckInterval;
+            if(fresh && (!cachedFile || isLoaded(*cachedFile, loadFlags))) return cachedFile;
+        }
+    }
+
+    struct _stat64 fileStatus;
+    if(_stat64(filePath.c_str(), &fileStatus) != 0 || !(fileStatus.st_mode & S_IFREG)){
+        cachedFile = nullptr;
+    }
+    else{
+        cachedFile = loadFile(filePath, static_cast<std::uint64_t>(fileStatus.st_size), static_cast<std::time_t>(fileStatus.st_mtime), cachedFile, loadFlags);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if(entries.size() >= maxEntries && entries.find(filePath) == entries.end()) entries.clear();
+    Entry& entry = entries[filePath];
+    entry.file = cachedFile;
+    entry.checkedAt = now;
+    return cachedFile;
+}
+
+/**
+ * @brief Checks whether a cached file holds everything a lookup asks for.
+ */
+bool ValidatorCache::isLoaded(const CachedFile &cachedFile, int loadFlags){
+    if((loadFlags & LOAD_CONTENT) && !cachedFile.content) return false;
+    if((loadFlags & LOAD_FINGERPRINT) && cachedFile.fingerprint.empty()) return false;
+    return true;
+}
+
+/**
+ * @brief Hashes the content of a file with 64-bit FNV-1a, reading it in pieces.
+ *
+ * @param filePath The path of the file.
+ * @param fingerprint Set to the first 8 hex digits of the hash.
+ * @return False if the file cannot be read.
+ */
+static bool fingerprintFile(const std::string &filePath, std::string &fingerprint){
+    std::ifstream fileStream(filePath, std::ios::binary);
+    if(!fileStream) return false;
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    char buffer[16 * 1024];
+    while(fileStream.read(buffer, sizeof(buffer)) || fileStream.gcount() > 0){
+        std::streamsize count = fileStream.gcount();
+        for(std::streamsize i = 0; i < count; i++){
+            hash = (hash ^ static_cast<unsigned char>(buffer[i])) * 0x100000001b3ull;
+        }
+    }
+    static const char hexDigits[] = "0123456789abcdef";
+    fingerprint.resize(8);
+    for(int i = 0; i < 8; i++){
+        fingerprint[i] = hexDigits[(hash >> (60 - 4 * i)) & 0xf];
+    }
+    return true;
+}
+
+/**
+ * @brief Renews the validators of a file if it changed, and loads what a lookup asks for.
+ *
+ * @param filePath The path of the file.
+ * @param size The current size of the file.
+ * @param modifiedTime The current modification time of the file.
+ * @param cachedFile The previously cached version, nullptr if there is none.
+ * @param loadFlags What to load besides the validators, see LoadFlags.
+ * @return The current version, cachedFile itself if it is unchanged and complete. nullptr if the file could not be read.
+ */
+std::shared_ptr<const ValidatorCache::CachedFile> ValidatorCache::loadFile(const std::string &filePath, std::uint64_t size, std::time_t modifiedTime, std::shared_ptr<const CachedFile> cachedFile, int loadFlags){
+    bool unchanged = cachedFile && cachedFile->size == size && cachedFile->modifiedTime == modifiedTime;
+    if(unchanged && isLoaded(*cachedFile, loadFlags)) return cachedFile;
+
+    std::shared_ptr<CachedFile> file = makeCachedFile(size, modifiedTime);
+    if(unchanged){
+        file->content = cachedFile->content;
+        file->fingerprint = cachedFile->fingerprint;
+    }
+    if((loadFlags & LOAD_CONTENT) && !file->content){
+        std::ifstream fileStream(filePath, std::ios::binary);
+        if(!fileStream) return nullptr;
+        std::ostringstream contents;
+        contents << fileStream.rdbuf();
+        file->content = std::make_shared<const std::string>(contents.str());
+    }
+    if((loadFlags & LOAD_FINGERPRINT) && file->fingerprint.empty()){
+        if(!fingerprintFile(filePath, file->fingerprint)) return nullptr;
+    }
+    return file;
+}
+
+/**
+ * @brief Forgets all files, e.g. after deploying new files with an unchanged size and modification time.
+ */
+void ValidatorCache::clear(){
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+}
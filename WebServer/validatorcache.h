@@ -0,0 +1,72 @@
+#ifndef VALIDATORCACHE_H
+#define VALIDATORCACHE_H
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @brief Caches the validators of served files (`ETag`, `Last-Modified`), and the content of templates.
+ *
+ * A file is looked up by its path. The first lookup reads its size and modification time with
+ * `_stat64`, later lookups within recheckInterval seconds are answered from memory, so answering a
+ * conditional request with 304 does not touch the file system. After the interval the file is
+ * checked again and its validators are renewed if it changed. Missing files are remembered as well,
+ * so probing for an optional file, such as a precompressed sibling, is just as cheap.
+ *
+ * The ETag is strong and built from the size and modification time, e.g. `"1a2b-65f0c3a1"`, which
+ * identifies a version of the file without hashing its content.
+ *
+ * On request the cache also keeps the content of a file (for templates) or a fingerprint of its
+ * content (for fingerprinted asset URLs, see StaticMount), computed once per version of the file.
+ *
+ * The cache is shared by all servers of the process and can be used from several threads.
+ */
+class ValidatorCache{
+public:
+    /**
+     * @brief The validators of a version of a file, and its content if it was requested.
+     */
+    struct CachedFile {
+        std::string etag;               ///< The strong entity tag, including its quotes
+        std::string lastModified;       ///< The modification time as an HTTP date
+        std::time_t modifiedTime = 0;
+        std::uint64_t size = 0;
+        std::shared_ptr<const std::string> content;     ///< The bytes of the file, only loaded with LOAD_CONTENT
+        std::string fingerprint;        ///< A hash of the content in hex, only computed with LOAD_FINGERPRINT
+    };
+
+    /**
+     * @brief What lookup loads besides the validators, combined with `|`.
+     */
+    enum LoadFlags {
+        LOAD_VALIDATORS = 0,
+        LOAD_CONTENT = 1,
+        LOAD_FINGERPRINT = 2
+    };
+
+    static const std::time_t recheckInterval = 1;      ///< Seconds during which a looked up file is not checked again
+    static const std::size_t maxEntries = 4096;         ///< The cache is emptied when it grows beyond this, e.g. from requests for many missing files
+
+private:
+    struct Entry {
+        std::shared_ptr<const CachedFile> file;     ///< nullptr if the file does not exist
+        std::time_t checkedAt = 0;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<std::string, Entry> entries;
+
+    static std::shared_ptr<const CachedFile> loadFile(const std::string& filePath, std::uint64_t size, std::time_t modifiedTime, std::shared_ptr<const CachedFile> cachedFile, int loadFlags);
+    static bool isLoaded(const CachedFile& cachedFile, int loadFlags);
+
+public:
+    static ValidatorCache& global();
+
+    std::shared_ptr<const CachedFile> lookup(const std::string& filePath, int loadFlags = LOAD_VALIDATORS);
+    void clear();
+};
+
+#endif
@@ -0,0 +1,95 @@
+/*
+Handler dispatch benchmark: plain function pointer vs. InlineFunction (holding a function pointer or
+a capturing lambda) vs. std::function (holding a capture too large for its small buffer).
+
+The handlers take and return an int, so the measurement is the dispatch itself rather than the
+construction of a Response. Global operator new is replaced by a counting version to show which
+wrappers allocate.
+
+Build and run from the project directory:
+
+g++ -std=c++17 -O2 -o handler_benchmark benchmarks/handler_benchmark.cpp
+./handler_benchmark
+*/
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "../WebServer/inlinefunction.h"
+
+std::size_t heapAllocations = 0;
+
+void* operator new(std::size_t size){
+    heapAllocations++;
+    if(void* memory = std::malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept{
+    std::free(memory);
+}
+
+const std::size_t callCount = 50000000;
+const std::size_t handlerCount = 16;       // Calls rotate through several handlers, as a server does through its routes
+
+int plainHandler(int request){
+    return request + 1;
+}
+
+template <typename Handler>
+void runBenchmark(const std::string& name, std::vector<Handler>& handlers){
+    std::uint64_t checksum = 0;
+    std::size_t allocationsBefore = heapAllocations;
+    auto start = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < callCount; i++){
+        checksum += handlers[i % handlerCount](static_cast<int>(i));
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::size_t allocations = heapAllocations - allocationsBefore;
+
+    if(checksum == 1) std::cout << "";     // keep the calls from being optimized away
+    std::cout << name << ": " << std::chrono::duration<double, std::nano>(end - start).count() / callCount << " ns per call, "
+              << allocations << " heap allocations during calls" << std::endl;
+}
+
+int main(){
+    std::vector<int (*)(int)> functionPointers(handlerCount, &plainHandler);
+    runBenchmark("function pointer", functionPointers);
+
+    std::vector<InlineFunction<int(int)>> inlinePointers;
+    for(std::size_t i = 0; i < handlerCount; i++){
+        inlinePointers.emplace_back(&plainHandler);
+    }
+    runBenchmark("InlineFunction, function pointer", inlinePointers);
+
+    int offset = 1;
+    std::array<std::int64_t, 4> state = {1, 2, 3, 4};
+    std::vector<InlineFunction<int(int)>> inlineLambdas;
+    inlineLambdas.reserve(handlerCount);
+    std::size_t allocationsBefore = heapAllocations;
+    for(std::size_t i = 0; i < handlerCount; i++){
+        inlineLambdas.emplace_back([&offset, state](int request){ return request + offset + static_cast<int>(state[3]); });
+    }
+    std::cout << "InlineFunction construction: " << heapAllocations - allocationsBefore << " heap allocations for " << handlerCount << " capturing lambdas" << std::endl;
+    runBenchmark("InlineFunction, capturing lambda", inlineLambdas);
+
+    std::vector<std::function<int(int)>> standardFunctions;
+    standardFunctions.reserve(handlerCount);
+    allocationsBefore = heapAllocations;
+    for(std::size_t i = 0; i < handlerCount; i++){
+        standardFunctions.emplace_back([&offset, state](int request){ return request + offset + static_cast<int>(state[3]); });
+    }
+    std::cout << "std::function construction: " << heapAllocations - allocationsBefore << " heap allocations for " << handlerCount << " capturing lambdas" << std::endl;
+    runBenchmark("std::function, capturing lambda", standardFunctions);
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*
+JSON serialization benchmark: JsonWriter vs. nlohmann::json dump() vs. string concatenation, for a
+document of 10 000 user records with a few strings that need escaping.
+
+The nlohmann and concatenation variants build a temporary string and copy it into the response
+body, as setContent does. JsonWriter writes into the body string directly. Global operator new is
+replaced by a counting version to show the allocations of each variant. Build with
+-DWEBSERVER_JSON_NO_SIMD to measure the scalar string escaping.
+
+Build and run from the project directory:
+
+g++ -std=c++17 -O2 -o json_benchmark benchmarks/json_benchmark.cpp WebServer/jsonwriter.cpp WebServer/responsebody.cpp
+./json_benchmark
+*/
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "../WebServer/jsonwriter.h"
+#include "../WebServer/nlohmann/json.hpp"
+
+std::size_t heapAllocations = 0;
+
+void* operator new(std::size_t size){
+    heapAllocations++;
+    if(void* memory = std::malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept{
+    std::free(memory);
+}
+
+const std::size_t recordCount = 10000;
+const int runCount = 50;
+
+struct User {
+    std::int64_t id;
+    std::string name;
+    std::string email;
+    std::string bio;
+    double score;
+    bool active;
+};
+
+std::string concatenate(const std::vector<User>& users){
+    std::string json = "[";
+    for(std::size_t i = 0; i < users.size(); i++){
+        const User& user = users[i];
+        if(i > 0) json += ",";
+        // Only correct as long as no string needs escaping, which is the usual bug of this approach
+        json += R"({"id":)" + std::to_string(user.id) + R"(,"name":")" + user.name + R"(","email":")" + user.email +
+                R"(","bio":")" + user.bio + R"(","score":)" + std::to_string(user.score) + R"(,"active":)" + (user.active ? "true" : "false") + "}";
+    }
+    json += "]";
+    return json;
+}
+
+std::string dumpNlohmann(const std::vector<User>& users){
+    nlohmann::json json = nlohmann::json::array();
+    for(const User& user : users){
+        json.push_back({{"id", user.id}, {"name", user.name}, {"email", user.email}, {"bio", user.bio}, {"score", user.score}, {"active", user.active}});
+    }
+    return json.dump();
+}
+
+void writeJson(const std::vector<User>& users, std::string& body){
+    JsonWriter json(body);
+    json.beginArray();
+    for(const User& user : users){
+        json.beginObject();
+        json.member("id", user.id);
+        json.member("name", user.name);
+        json.member("email", user.email);
+        json.member("bio", user.bio);
+        json.member("score", user.score);
+        json.member("active", user.active);
+        json.endObject();
+    }
+    json.endArray();
+}
+
+template <typename Serialize>
+void runBenchmark(const std::string& name, Serialize serialize){
+    std::size_t bytes = 0;
+    std::size_t allocationsBefore = heapAllocations;
+    auto start = std::chrono::steady_clock::now();
+    for(int run = 0; run < runCount; run++){
+        std::string body;
+        serialize(body);
+        bytes = body.size();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double milliseconds = std::chrono::duration<double, std::milli>(end - start).count() / runCount;
+    std::cout << name << ": " << milliseconds << " ms per document (" << bytes << " bytes, "
+              << bytes / milliseconds / 1e6 << " GB/s), " << (heapAllocations - allocationsBefore) / runCount << " heap allocations" << std::endl;
+}
+
+int main(){
+    std::vector<User> users;
+    users.reserve(recordCount);
+    for(std::size_t i = 0; i < recordCount; i++){
+        std::string bio = "Writes C++ for a living and enjoys long walks through template error messages. ";
+        if(i % 10 == 0) bio += "Says \"hello\"\tin C:\\Users\\name\n";
+        users.push_back(User{static_cast<std::int64_t>(i), "User " + std::to_string(i), "user" + std::to_string(i) + "@example.com", bio, i * 0.25, i % 3 == 0});
+    }
+
+    runBenchmark("string concatenation + copy", [&](std::string& body){ std::string json = concatenate(users); body = json; });
+    runBenchmark("nlohmann dump() + copy", [&](std::string& body){ std::string json = dumpNlohmann(users); body = json; });
+    runBenchmark("JsonWriter", [&](std::string& body){ writeJson(users, body); });
+    runBenchmark("JsonWriter with reserve", [&](std::string& body){ body.reserve(2 * 1024 * 1024); writeJson(users, body); });
+    return 0;
+}
@@ -0,0 +1,97 @@
+/*
+Router benchmark: compile-time perfect hash table (StaticRouteTable) vs. radix tree (RadixTree)
+for 10, 1 000 and 50 000 exact-match routes.
+
+Build and run from the project directory. The router and the in-memory parts of Response do not
+depend on Winsock or the Windows file APIs, the Response functions that read files live in
+WebServer/responsefile.cpp and are left out:
+
+g++ -std=c++17 -O2 -o router_benchmark benchmarks/router_benchmark.cpp WebServer/radixtree.cpp WebServer/radixnode.cpp WebServer/routematch.cpp WebServer/patterndfa.cpp WebServer/routepattern.cpp WebServer/httpmethod.cpp WebServer/request.cpp WebServer/requestcontext.cpp WebServer/response.cpp WebServer/responsebody.cpp WebServer/httpdate.cpp WebServer/httpstatus.cpp WebServer/httpheader.cpp WebServer/responseheaders.cpp WebServer/middleware.cpp
+./router_benchmark
+*/
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../WebServer/radixtree.h"
+#include "../WebServer/staticroutetable.h"
+
+Response benchmarkHandler([[maybe_unused]] Request& req){
+    return Response();
+}
+
+const std::size_t lookupCount = 2000000;
+
+// Routes look like real API routes and share long prefixes: /api/v1/resource17/items
+std::vector<std::string> generateRoutes(std::size_t routeCount){
+    std::vector<std::string> routes;
+    for(std::size_t i = 0; i < routeCount; i++){
+        routes.push_back("/api/v1/resource" + std::to_string(i) + "/items");
+    }
+    return routes;
+}
+
+template <typename Lookup>
+double nanosecondsPerLookup(const std::vector<std::string>& requests, Lookup lookup){
+    std::uintptr_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < lookupCount; i++){
+        checksum += lookup(requests[i % requests.size()]);
+    }
+    auto end = std::chrono::steady_clock::now();
+    if(checksum == 1) std::cout << "";     // keep the lookups from being optimized away
+    return std::chrono::duration<double, std::nano>(end - start).count() / lookupCount;
+}
+
+template <std::size_t N>
+void runBenchmark(){
+    std::vector<std::string> routes = generateRoutes(N);
+
+    std::unique_ptr<std::array<StaticRoute, N>> staticRoutes(new std::array<StaticRoute, N>());
+    for(std::size_t i = 0; i < N; i++){
+        (*staticRoutes)[i] = StaticRoute{HTTP_GET, routes[i], &benchmarkHandler};
+    }
+    auto buildStart = std::chrono::steady_clock::now();
+    std::unique_ptr<StaticRouteTable<N>> table(new StaticRouteTable<N>(*staticRoutes));
+    auto buildEnd = std::chrono::steady_clock::now();
+
+    RadixTree tree;
+    std::shared_ptr<ResponseFunction> handler = std::make_shared<ResponseFunction>(&benchmarkHandler);
+    for(const std::string& route : routes){
+        tree.insert(HTTP_GET, route, handler);
+    }
+    tree.freeze();
+
+    // Request every route in random order, plus 10% misses
+    std::vector<std::string> requests(routes);
+    for(std::size_t i = 0; i < N / 10 + 1; i++){
+        requests.push_back("/api/v1/resource" + std::to_string(i) + "/missing");
+    }
+    std::shuffle(requests.begin(), requests.end(), std::mt19937(42));
+
+    double staticTime = nanosecondsPerLookup(requests, [&](const std::string& request){
+        return static_cast<std::uintptr_t>(table->indexOf(HTTP_GET, request));
+    });
+    double radixTime = nanosecondsPerLookup(requests, [&](const std::string& request){
+        RouteMatch routeMatch = tree.search(HTTP_GET, request);
+        return static_cast<std::uintptr_t>(routeMatch.methodAllowed()) + routeMatch.getRouteParams().size();
+    });
+
+    std::cout << N << " routes:" << std::endl;
+    std::cout << "  static table build (runtime): " << std::chrono::duration<double, std::milli>(buildEnd - buildStart).count() << " ms" << std::endl;
+    std::cout << "  static table lookup: " << staticTime << " ns" << std::endl;
+    std::cout << "  radix tree lookup:   " << radixTime << " ns" << std::endl;
+}
+
+int main(){
+    runBenchmark<10>();
+    runBenchmark<1000>();
+    runBenchmark<50000>();
+    return 0;
+}
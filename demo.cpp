@@ -6,8 +6,6 @@
 #include "WebServer/server.h"
 #include "WebServer/database.h"
 
-SqliteDatabase database("database.db");
-
 // Function that handles '/' route
 Response HomePage(Request& req){
     Response res;
@@ -48,47 +46,35 @@ http://127.0.0.1/api/social-media?search=twitter (Should get not found error)
 
 */
 Response GETRequestAPI(Request& req){
-    std::unordered_map<std::string,std::string> queryParams =  req.getRequestQuery();
-
-    Response res;
-    res.setContentType("application/json");
-    std::string jsonContent;
-
+    static const std::pair<const char*, const char*> socialMediaLinks[] = {
+        {"linkedin", "https://www.linkedin.com/in/tirthraj-mahajan/"},
+        {"github", "https://github.com/tirthraj07"},
+        {"instagram", "https://www.instagram.com/tirthraj07/"}
+    };
+    const std::unordered_map<std::string,std::string>& queryParams = req.getRequestQuery();
     auto it = queryParams.find("search");
 
-    if(it == queryParams.end()){    
-        jsonContent = R"({"linkedin":"https://www.linkedin.com/in/tirthraj-mahajan/", "github":"https://github.com/tirthraj07", "instagram":"https://www.instagram.com/tirthraj07/"})";
-        res.setContent(jsonContent);
-        res.setStatusCode(200);
-    }
-    else{
-        if(it->second == "linkedin"){
-            jsonContent = R"({"linkedin":"https://www.linkedin.com/in/tirthraj-mahajan/"})";
-            res.setContent(jsonContent);
-            res.setStatusCode(200);
-        }
-        else if(it->second == "github"){
-            jsonContent = R"({"github":"https://github.com/tirthraj07"})";
-            res.setContent(jsonContent);
-            res.setStatusCode(200);
-        }
-        else if(it->second == "instagram"){
-            jsonContent = R"({"instagram":"https://www.instagram.com/tirthraj07/"})";
-            res.setContent(jsonContent);
-            res.setStatusCode(200);
-        }
-        else{
-            jsonContent = R"({"error":"Not Found"})";
-            res.setContent(jsonContent);
-            res.setStatusCode(404);
+    // The JSON is written straight into the response body, without a temporary string
+    Response res;
+    JsonWriter json(res);
+    json.beginObject();
+    bool found = false;
+    for(const auto& link : socialMediaLinks){
+        if(it == queryParams.end() || it->second == link.first){
+            json.member(link.first, link.second);
+            found = true;
         }
     }
-
+    if(!found){
+        json.member("error", "Not Found");
+        res.setStatusCode(404);
+    }
+    json.endObject();
     return res;
 }
 
-// Function that handles the '/api/form' route
-Response POSTRequestAPI(Request& req){
+// Function that handles the '/api/form' route, the database is passed in by the lambda registered in main()
+Response POSTRequestAPI(Request& req, SqliteDatabase& database){
     std::unordered_map<std::string, std::string> requestBody = req.getRequestBody();
     std::string name = requestBody["name"];
     std::string email = requestBody["email"];
@@ -122,11 +108,15 @@ Response POSTRequestAPI(Request& req){
     return res;
 }
 
+// The key checked by the first middleware, attached to the request for the middleware after it
+ContextKey<std::string> treasureKey;
+
 // First Middleware for '/treasure' route
-Response middlewareFunctionForTreasurePage(Request& req){
-    std::unordered_map<std::string, std::string> queryParams = req.getRequestQuery();
-    std::string treasureKey = queryParams["key"];
-    if(treasureKey == "123"){
+MiddlewareResult middlewareFunctionForTreasurePage(Request& req){
+    const std::unordered_map<std::string, std::string>& queryParams = req.getRequestQuery();
+    auto key = queryParams.find("key");
+    if(key != queryParams.end() && key->second == "123"){
+        req.setContext(treasureKey, key->second);
         return Middleware::next();
     }
 
@@ -137,8 +127,8 @@ Response middlewareFunctionForTreasurePage(Request& req){
 }
 
 // Second Middleware for '/treasure' route
-Response anotherMiddlewareFunctionForTreasurePage(Request& req){
-    std::cout<<"Someone is accessing treasure 0_0"<<std::endl;
+MiddlewareResult anotherMiddlewareFunctionForTreasurePage(Request& req){
+    std::cout<<"Someone is accessing treasure with key "<<*req.getContext(treasureKey)<<" 0_0"<<std::endl;
     return Middleware::next();
 }
 
@@ -150,7 +140,15 @@ Response loadTreasurePage(Request& req){
 }
 
 
-bool InitDatabase(){
+// Exact-match routes known at compile time, dispatched through a perfect hash table
+constexpr auto staticRoutes = makeStaticRouteTable(
+    StaticRoute{HTTP_GET, "/", &HomePage},
+    StaticRoute{HTTP_GET, "/about", &AboutPage},
+    StaticRoute{HTTP_GET, "/google", &redirectToGoogle},
+    StaticRoute{HTTP_GET, "/cpp", &serveImage}
+);
+
+bool InitDatabase(SqliteDatabase& database){
     std::string sql = "CREATE TABLE IF NOT EXISTS users (" \
                        "NAME TEXT NOT NULL," \
                        "EMAIL TEXT NOT NULL PRIMARY KEY" \
@@ -176,14 +174,16 @@ int main(){
     // Instantiate the Server
     WebServer server = WebServer(PORT,IPAddr);
 
+    // Open the database, route functions that need it capture it
+    SqliteDatabase database("database.db");
+
     // Link routes to the server
 
     // GET Routes
-    server.get("/", &HomePage);
-    server.get("/about", &AboutPage);
     server.get("/api/social-media", &GETRequestAPI);
-    server.get("/google",&redirectToGoogle);
-    server.get("/cpp", &serveImage);
+
+    // Fixed routes can be dispatched through a table built at compile time, they still run global middleware and after hooks
+    server.useStaticRoutes(staticRoutes);
 
     // Create a middleware list for the '/treasure' route
     Middleware treasureRouteMiddleware;
@@ -194,11 +194,11 @@ int main(){
     server.get("/treasure",&loadTreasurePage,treasureRouteMiddleware);
 
     // POST Routes
-    server.post("/api/form", &POSTRequestAPI);
+    server.post("/api/form", [&database](Request& req){ return POSTRequestAPI(req, database); });
 
 
     // Initialize the database and run the server
-    if(InitDatabase()){
+    if(InitDatabase(database)){
         // Run the server
         server.run();        
     };
@@ -0,0 +1,189 @@
+/*
+HTTP tests: checks the parsers and serializers that do not touch the network, the Range header
+parser, the HTTP date format, the Accept-Encoding negotiation and the JSON writer.
+
+The program prints every failed check and exits with status 1 if any check fails.
+
+Build and run from the project directory. WebServer/fileregion.cpp uses the Windows file APIs and
+is left out, none of the checks reads a file:
+
+g++ -std=c++17 -O2 -o http_test tests/http_test.cpp WebServer/byterange.cpp WebServer/httpdate.cpp WebServer/contentencoding.cpp WebServer/jsonwriter.cpp WebServer/httpheader.cpp WebServer/responsebody.cpp
+./http_test
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../WebServer/byterange.h"
+#include "../WebServer/httpdate.h"
+#include "../WebServer/contentencoding.h"
+#include "../WebServer/jsonwriter.h"
+
+int failedChecks = 0;
+
+void check(bool condition, const std::string& description){
+    if(condition) return;
+    std::cout << "FAILED: " << description << std::endl;
+    failedChecks++;
+}
+
+// The ranges as "offset+length" pairs, e.g. "0+500 9500+500", or the status if none are satisfiable
+std::string parseRanges(std::string_view rangeHeader, std::uint64_t size){
+    std::vector<ByteRange> ranges;
+    RangeStatus status = parseByteRanges(rangeHeader, size, ranges);
+    if(status == RANGE_IGNORED) return "ignored";
+    if(status == RANGE_NOT_SATISFIABLE) return "unsatisfiable";
+    std::string result;
+    for(const ByteRange& range : ranges){
+        if(!result.empty()) result += ' ';
+        result += std::to_string(range.offset) + "+" + std::to_string(range.length);
+    }
+    return result;
+}
+
+// Ranges are resolved against the size of the representation, invalid headers are ignored, several ranges are framed as multipart
+void testByteRanges(){
+    check(parseRanges("bytes=0-499", 10000) == "0+500", "bytes=0-499 is the first 500 bytes");
+    check(parseRanges("bytes=9500-", 10000) == "9500+500", "bytes=9500- runs to the end");
+    check(parseRanges("bytes=-500", 10000) == "9500+500", "bytes=-500 is the last 500 bytes");
+    check(parseRanges("bytes=-20000", 10000) == "0+10000", "a suffix longer than the file is the whole file");
+    check(parseRanges("bytes=9000-20000", 10000) == "9000+1000", "a last position beyond the end is cut off");
+    check(parseRanges("bytes=0-0, -1", 10000) == "0+1 9999+1", "several ranges keep the order of the header");
+    check(parseRanges("BYTES=0-9", 10000) == "0+10", "the range unit is compared ignoring case");
+    check(parseRanges(" bytes=0-9 ", 10000) == "0+10", "spaces around the header are ignored");
+
+    check(parseRanges("bytes=-0", 10000) == "unsatisfiable", "bytes=-0 selects nothing");
+    check(parseRanges("bytes=10000-", 10000) == "unsatisfiable", "a range starting at the end is unsatisfiable");
+    check(parseRanges("bytes=20000-30000, -0", 10000) == "unsatisfiable", "ranges that all miss are unsatisfiable");
+    check(parseRanges("bytes=20000-30000, 0-9", 10000) == "0+10", "a range that misses is dropped from the others");
+    check(parseRanges("bytes=-5", 0) == "unsatisfiable", "no suffix of an empty file is satisfiable");
+
+    check(parseRanges("", 10000) == "ignored", "an empty header is ignored");
+    check(parseRanges("items=0-9", 10000) == "ignored", "another unit is ignored");
+    check(parseRanges("bytes=", 10000) == "ignored", "a header without ranges is ignored");
+    check(parseRanges("bytes=9-0", 10000) == "ignored", "a last position before the first is ignored");
+    check(parseRanges("bytes=a-9", 10000) == "ignored", "a range that is not a number is ignored");
+    check(parseRanges("bytes=0-99999999999999999999", 10000) == "ignored", "a position that overflows is ignored");
+
+    std::string manyRanges = "bytes=0-0";
+    for(std::size_t i = 1; i < maxByteRanges; i++) manyRanges += ", " + std::to_string(i) + "-" + std::to_string(i);
+    std::string servedRanges = parseRanges(manyRanges, 10000);
+    check(std::count(servedRanges.begin(), servedRanges.end(), '+') == maxByteRanges, "maxByteRanges ranges are served");
+    check(parseRanges(manyRanges + ", 99-99", 10000) == "ignored", "a header with more than maxByteRanges ranges is ignored");
+
+    check(formatContentRange(ByteRange{9500, 500}, 10000) == "bytes 9500-9999/10000", "Content-Range names the first and last byte");
+
+    std::vector<ByteRange> multipartRanges{ByteRange{0, 10}, ByteRange{100, 5}};
+    std::string partHeaders = "--B\r\nContent-Type: text/plain\r\nContent-Range: bytes 0-9/1000\r\n\r\n"
+                              "\r\n--B\r\nContent-Type: text/plain\r\nContent-Range: bytes 100-104/1000\r\n\r\n"
+                              "\r\n--B--\r\n";
+    check(formatMultipartHeader(0, multipartRanges, 1000, "text/plain", "B") + formatMultipartHeader(1, multipartRanges, 1000, "text/plain", "B")
+          + formatMultipartHeader(2, multipartRanges, 1000, "text/plain", "B") == partHeaders, "multipart parts are delimited by the boundary");
+    check(multipartByteRangesLength(multipartRanges, 1000, "text/plain", "B") == partHeaders.size() + 15, "the multipart length counts the part headers and ranges");
+}
+
+// Formats a time and parses it back
+std::string formatDate(std::time_t seconds){
+    char formatted[HttpDate::formattedLength];
+    HttpDate::format(seconds, formatted);
+    return std::string(formatted, HttpDate::formattedLength);
+}
+
+bool roundTrips(std::time_t seconds){
+    std::time_t parsed = 0;
+    return HttpDate::parse(formatDate(seconds), parsed) && parsed == seconds;
+}
+
+// Dates are formatted and parsed in the IMF-fixdate format, around leap days and centuries too
+void testHttpDate(){
+    check(formatDate(0) == "Thu, 01 Jan 1970 00:00:00 GMT", "the epoch is formatted");
+    check(formatDate(784111777) == "Sun, 06 Nov 1994 08:49:37 GMT", "the example date of RFC 9110 is formatted");
+    check(formatDate(951868799) == "Tue, 29 Feb 2000 23:59:59 GMT", "the leap day of 2000 is formatted");
+    check(formatDate(951868800) == "Wed, 01 Mar 2000 00:00:00 GMT", "the day after the leap day of 2000 is formatted");
+    check(formatDate(1709164800) == "Thu, 29 Feb 2024 00:00:00 GMT", "the leap day of 2024 is formatted");
+    check(formatDate(4107542400) == "Mon, 01 Mar 2100 00:00:00 GMT", "2100 has no leap day");
+
+    for(std::time_t seconds : {std::time_t(0), std::time_t(784111777), std::time_t(951696000), std::time_t(951782400), std::time_t(951868799),
+                               std::time_t(951868800), std::time_t(1709164799), std::time_t(1709251199), std::time_t(4107456000),
+                               std::time_t(4107542400), std::time_t(-1)}){
+        check(roundTrips(seconds), "the date " + formatDate(seconds) + " is parsed back");
+    }
+
+    std::time_t parsed = 0;
+    check(HttpDate::parse("Sun, 06 Nov 1994 08:49:37 GMT", parsed) && parsed == 784111777, "the example date of RFC 9110 is parsed");
+    check(!HttpDate::parse("Sunday, 06-Nov-94 08:49:37 GMT", parsed), "the RFC 850 format is rejected");
+    check(!HttpDate::parse("Sun Nov  6 08:49:37 1994", parsed), "the asctime format is rejected");
+    check(!HttpDate::parse("Sun, 06 Nov 1994 08:49:37 UTC", parsed), "a zone other than GMT is rejected");
+    check(!HttpDate::parse("Sun, 06 Foo 1994 08:49:37 GMT", parsed), "an unknown month is rejected");
+    check(!HttpDate::parse("Sun, 06 Nov 1994 24:00:00 GMT", parsed), "hour 24 is rejected");
+    check(!HttpDate::parse("Sun, 06 Nov 1994 08:49:37 GMT ", parsed), "trailing text is rejected");
+
+    HttpDate httpDate;
+    check(httpDate.getHeaderLine(784111777) == "Date: Sun, 06 Nov 1994 08:49:37 GMT\r\n", "the Date header line carries the date and a CRLF");
+}
+
+// The accepted encoding with the highest quality wins, br before gzip before deflate on equal quality
+void testContentEncodingNegotiation(){
+    const bool allEncodings[ENCODING_COUNT] = {true, true, true, true};
+    const bool gzipOnly[ENCODING_COUNT] = {true, true, false, false};
+
+    check(negotiateContentEncoding("gzip, deflate, br", allEncodings) == ENCODING_BROTLI, "br is preferred on equal quality");
+    check(negotiateContentEncoding("gzip, deflate, br", gzipOnly) == ENCODING_GZIP, "only available encodings are picked");
+    check(negotiateContentEncoding("br;q=0.5, gzip;q=0.8", allEncodings) == ENCODING_GZIP, "the highest quality wins");
+    check(negotiateContentEncoding("GZIP;Q=1.0", allEncodings) == ENCODING_GZIP, "codings and q are compared ignoring case");
+    check(negotiateContentEncoding("x-gzip", allEncodings) == ENCODING_GZIP, "x-gzip is gzip");
+    check(negotiateContentEncoding("gzip;q=0", allEncodings) == ENCODING_IDENTITY, "q=0 refuses an encoding");
+    check(negotiateContentEncoding("*", allEncodings) == ENCODING_BROTLI, "* accepts every encoding");
+    check(negotiateContentEncoding("*, br;q=0", allEncodings) == ENCODING_GZIP, "a listed encoding overrides *");
+    check(negotiateContentEncoding("identity", allEncodings) == ENCODING_IDENTITY, "identity compresses nothing");
+    check(negotiateContentEncoding("", allEncodings) == ENCODING_IDENTITY, "an empty header compresses nothing");
+    check(std::string(contentEncodingName(ENCODING_BROTLI)) == "br", "brotli is named br");
+}
+
+// Strings are escaped and commas placed between values, but not after keys or before closing brackets
+void testJsonWriter(){
+    std::string output;
+    JsonWriter json(output);
+    json.beginObject();
+    json.member("name", "Ada");
+    json.key("tags").beginArray().value(1).value(-2).value(true).value(nullptr).endArray();
+    json.key("empty").beginObject().endObject();
+    json.key("nested").beginArray().beginArray().endArray().beginObject().endObject().endArray();
+    json.member("ratio", 0.5);
+    json.endObject();
+    check(output == R"({"name":"Ada","tags":[1,-2,true,null],"empty":{},"nested":[[],{}],"ratio":0.5})", "commas separate values and members only");
+
+    std::string escaped;
+    JsonWriter::appendString(escaped, "quote\" backslash\\ newline\n tab\t bell\x07 slash/ \xc3\xa9");
+    check(escaped == "\"quote\\\" backslash\\\\ newline\\n tab\\t bell\\u0007 slash/ \xc3\xa9\"", "quotes, backslashes and control characters are escaped");
+
+    std::string longText(40, 'a');
+    longText[33] = '"';
+    std::string escapedLong;
+    JsonWriter::appendString(escapedLong, longText);
+    check(escapedLong == "\"" + std::string(33, 'a') + "\\\"" + std::string(6, 'a') + "\"", "characters after the first 16-byte block are escaped");
+
+    std::string numbers;
+    JsonWriter numberWriter(numbers);
+    numberWriter.beginArray().value(INT64_MIN).value(UINT64_MAX).value(std::nan("")).value(1e300).endArray();
+    check(numbers == "[-9223372036854775808,18446744073709551615,null,1e+300]", "integers keep their range, NaN is written as null");
+}
+
+int main(){
+    testByteRanges();
+    testHttpDate();
+    testContentEncodingNegotiation();
+    testJsonWriter();
+
+    if(failedChecks){
+        std::cout << failedChecks << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
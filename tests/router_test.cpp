@@ -0,0 +1,314 @@
+/*
+Router tests: checks how RadixTree resolves overlapping static, parameter and wildcard routes
+registered for different methods, that the routes of a static route table resolve to the same
+routes as a tree search until they are removed, which regex syntax pattern routes accept, how overlapping pattern routes
+share a path, how long captured parameters stay valid, that lookups do not allocate, which routes
+run the middleware and after hooks of a route group and that move-only middleware can be registered.
+
+The program prints every failed check and exits with status 1 if any check fails.
+
+Build and run from the project directory. The router and the in-memory parts of Response do not
+depend on Winsock or the Windows file APIs, the Response functions that read files live in
+WebServer/responsefile.cpp and are left out:
+
+g++ -std=c++17 -O2 -o router_test tests/router_test.cpp WebServer/router.cpp WebServer/routegroup.cpp WebServer/radixtree.cpp WebServer/radixnode.cpp WebServer/routematch.cpp WebServer/patterndfa.cpp WebServer/routepattern.cpp WebServer/httpmethod.cpp WebServer/request.cpp WebServer/requestcontext.cpp WebServer/response.cpp WebServer/responsebody.cpp WebServer/httpdate.cpp WebServer/httpstatus.cpp WebServer/httpheader.cpp WebServer/responseheaders.cpp WebServer/middleware.cpp
+./router_test
+*/
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../WebServer/radixtree.h"
+#include "../WebServer/router.h"
+#include "../WebServer/routegroup.h"
+#include "../WebServer/staticroutetable.h"
+
+int failedChecks = 0;
+
+void check(bool condition, const std::string& description){
+    if(condition) return;
+    std::cout << "FAILED: " << description << std::endl;
+    failedChecks++;
+}
+
+// Global operator new is replaced by a counting version to check that route lookups do not allocate
+std::size_t heapAllocations = 0;
+
+void* operator new(std::size_t size){
+    heapAllocations++;
+    if(void* memory = std::malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept{
+    std::free(memory);
+}
+
+Response testHandler([[maybe_unused]] Request& req){
+    return Response();
+}
+
+MiddlewareResult testMiddleware([[maybe_unused]] Request& req){
+    return Middleware::next();
+}
+
+void testAfterHook([[maybe_unused]] Request& req, [[maybe_unused]] Response& res){}
+
+std::shared_ptr<ResponseFunction> handler(){
+    return std::make_shared<ResponseFunction>(&testHandler);
+}
+
+// The value captured for a parameter, or "-" if the route did not capture it
+std::string_view routeParam(const RouteMatch& routeMatch, std::string_view name){
+    for(const std::pair<std::string_view, std::string_view>& param : routeMatch.getRouteParams()){
+        if(param.first == name) return param.second;
+    }
+    return "-";
+}
+
+// GET /users/:id and POST /users/new share the path /users/new, each for its own method
+void testStaticRouteDoesNotHideParameterRoute(){
+    RadixTree tree;
+    tree.insert(HTTP_GET, RoutePattern("/users/:id"), handler());
+    tree.insert(HTTP_POST, RoutePattern("/users/new"), handler());
+
+    RouteMatch getMatch = tree.search(HTTP_GET, "/users/new");
+    check(getMatch.methodAllowed(), "GET /users/new matches GET /users/:id");
+    check(routeParam(getMatch, "id") == "new", "GET /users/new captures id=new");
+
+    RouteMatch postMatch = tree.search(HTTP_POST, "/users/new");
+    check(postMatch.methodAllowed(), "POST /users/new matches POST /users/new");
+    check(postMatch.getRouteParams().empty(), "POST /users/new captures no parameters");
+
+    RouteMatch putMatch = tree.search(HTTP_PUT, "/users/new");
+    check(putMatch.found() && !putMatch.methodAllowed(), "PUT /users/new is not allowed");
+    check(putMatch.getAllowHeader() == "GET, POST", "PUT /users/new lists the methods of both routes in Allow");
+
+    RouteMatch otherMatch = tree.search(HTTP_POST, "/users/42");
+    check(otherMatch.found() && !otherMatch.methodAllowed(), "POST /users/42 is not allowed");
+    check(otherMatch.getAllowHeader() == "GET", "POST /users/42 only lists GET in Allow");
+}
+
+// GET /files/*path and POST /files/upload share the path /files/upload, each for its own method
+void testStaticRouteDoesNotHideWildcardRoute(){
+    RadixTree tree;
+    tree.insert(HTTP_GET, RoutePattern("/files/*path"), handler());
+    tree.insert(HTTP_POST, RoutePattern("/files/upload"), handler());
+
+    RouteMatch getMatch = tree.search(HTTP_GET, "/files/upload");
+    check(getMatch.methodAllowed(), "GET /files/upload matches GET /files/*path");
+    check(routeParam(getMatch, "path") == "upload", "GET /files/upload captures path=upload");
+
+    RouteMatch deleteMatch = tree.search(HTTP_DELETE, "/files/upload");
+    check(deleteMatch.found() && !deleteMatch.methodAllowed(), "DELETE /files/upload is not allowed");
+    check(deleteMatch.getAllowHeader() == "GET, POST", "DELETE /files/upload lists the methods of both routes in Allow");
+
+    check(!tree.search(HTTP_GET, "/other").found(), "GET /other matches no route");
+}
+
+constexpr auto staticRoutes = makeStaticRouteTable(
+    StaticRoute{HTTP_GET, "/", &testHandler},
+    StaticRoute{HTTP_GET, "/about", &testHandler},
+    StaticRoute{HTTP_POST, "/about", &testHandler}
+);
+
+// A static route table hit yields the route a tree search finds, so both run the same middleware
+void testStaticRouteTableFindsTreeRoutes(){
+    Middleware globalMiddleware;
+    globalMiddleware.push(&testMiddleware);
+    globalMiddleware.pushAfter(&testAfterHook);
+
+    RadixTree tree;
+    tree.use(globalMiddleware);
+    for(const StaticRoute& staticRoute : staticRoutes){
+        tree.insert(staticRoute.method, std::string(staticRoute.route), std::make_shared<ResponseFunction>(staticRoute.responseFunction));
+    }
+    tree.insert(HTTP_GET, RoutePattern("/:page"), handler());
+    tree.bindStaticRoutes(std::vector<StaticRoute>(staticRoutes.begin(), staticRoutes.end()));
+
+    for(const StaticRoute& staticRoute : staticRoutes){
+        std::string description = std::string(httpMethodName(staticRoute.method)) + " " + std::string(staticRoute.route);
+        RouteMatch staticMatch = tree.searchStatic(staticRoutes.indexOf(staticRoute.method, staticRoute.route), staticRoute.method);
+        RouteMatch treeMatch = tree.search(staticRoute.method, staticRoute.route);
+        check(staticMatch.methodAllowed(), description + " is bound to a route");
+        check(staticMatch.getAllowHeader() == treeMatch.getAllowHeader(), description + " is bound to the route a tree search finds");
+        check(staticMatch.getMiddlewareChain().size() == 1, description + " runs the global middleware");
+        check(staticMatch.getAfterHookChain().size() == 1, description + " runs the global after hook");
+    }
+
+    check(staticRoutes.indexOf(HTTP_GET, "/contact") == staticRoutes.size(), "GET /contact is not in the table");
+    check(!tree.searchStatic(staticRoutes.indexOf(HTTP_GET, "/contact"), HTTP_GET).found(), "GET /contact is not bound to a route");
+}
+
+// A static route removed at runtime is no longer found through the table
+void testRemovedStaticRouteIsNotServed(){
+    Router router;
+    Middleware middleware;
+    for(const StaticRoute& staticRoute : staticRoutes){
+        router.addRoute(staticRoute.method, std::string(staticRoute.route), staticRoute.responseFunction, middleware);
+    }
+    router.setStaticRoutes(std::vector<StaticRoute>(staticRoutes.begin(), staticRoutes.end()));
+    router.publish();
+    router.removeRoute(HTTP_GET, "/about");
+
+    Router::ReadGuard routeTree(router);
+    check(!routeTree->searchStatic(staticRoutes.indexOf(HTTP_GET, "/about"), HTTP_GET).found(), "GET /about is no longer bound once removed");
+    check(routeTree->searchStatic(staticRoutes.indexOf(HTTP_POST, "/about"), HTTP_POST).methodAllowed(), "POST /about is still bound");
+    RouteMatch removedMatch = routeTree->search(HTTP_GET, "/about");
+    check(removedMatch.found() && !removedMatch.methodAllowed(), "GET /about is not allowed once removed");
+}
+
+// Whether registering a regex route throws
+bool rejectsRegex(const std::string& regex){
+    RadixTree tree;
+    try{
+        tree.insert(HTTP_GET, RoutePattern::regex(regex), handler());
+    }
+    catch(const std::runtime_error&){
+        return true;
+    }
+    return false;
+}
+
+// Regex syntax outside the supported subset is rejected instead of being matched literally
+void testUnsupportedRegexSyntax(){
+    check(rejectsRegex("/\\d{2}"), "/\\d{2} is rejected");
+    check(rejectsRegex("/a{2,1}"), "/a{2,1} is rejected");
+    check(rejectsRegex("/a}"), "/a} is rejected");
+    check(rejectsRegex("/a]"), "/a] is rejected");
+    check(rejectsRegex("/a^b"), "/a^b is rejected");
+    check(rejectsRegex("/a$b"), "/a$b is rejected");
+    check(rejectsRegex("/\\bitems"), "/\\bitems is rejected");
+
+    RadixTree tree;
+    tree.insert(HTTP_GET, RoutePattern::regex("^/v\\d+/items\\.json$"), handler());
+    check(tree.search(HTTP_GET, "/v12/items.json").methodAllowed(), "^/v\\d+/items\\.json$ matches /v12/items.json");
+    check(!tree.search(HTTP_GET, "/v12/itemsxjson").found(), "^/v\\d+/items\\.json$ does not match /v12/itemsxjson");
+}
+
+// GET glob /files/* and POST regex /files/.* both match /files/a, each for its own method
+void testOverlappingPatternRoutes(){
+    RadixTree tree;
+    tree.insert(HTTP_GET, RoutePattern::glob("/files/*"), handler());
+    tree.insert(HTTP_POST, RoutePattern::regex("/files/.*"), handler());
+
+    check(tree.search(HTTP_GET, "/files/a").methodAllowed(), "GET /files/a matches the glob route");
+    check(tree.search(HTTP_POST, "/files/a").methodAllowed(), "POST /files/a matches the regex route added second");
+    check(tree.search(HTTP_POST, "/files/a/b").methodAllowed(), "POST /files/a/b matches the regex route only");
+    check(!tree.search(HTTP_GET, "/files/a/b").methodAllowed(), "GET /files/a/b does not match the glob route");
+
+    RouteMatch deleteMatch = tree.search(HTTP_DELETE, "/files/a");
+    check(deleteMatch.found() && !deleteMatch.methodAllowed(), "DELETE /files/a is not allowed");
+    check(deleteMatch.getAllowHeader() == "GET, POST", "DELETE /files/a lists the methods of both patterns in Allow");
+}
+
+// A request keeps its parameters after the tree that matched it is deleted
+void testRouteParamsOutliveTree(){
+    RouteParams routeParams;
+    {
+        RadixTree tree;
+        tree.insert(HTTP_GET, RoutePattern("/orders/:orderId"), handler());
+        routeParams = tree.search(HTTP_GET, "/orders/7").getRouteParams();
+    }
+    check(routeParams.size() == 1 && routeParams[0].first == "orderId", "parameter names stay valid after the tree is deleted");
+}
+
+// Looking up static, parameter, wildcard and pattern routes does not allocate, nor does a miss or a 405
+void testLookupsDoNotAllocate(){
+    RadixTree tree;
+    tree.insert(HTTP_GET, RoutePattern("/api/v1/users"), handler());
+    tree.insert(HTTP_GET, RoutePattern("/api/v1/users/:id/posts/:post"), handler());
+    tree.insert(HTTP_GET, RoutePattern("/files/*path"), handler());
+    tree.insert(HTTP_GET, RoutePattern::glob("/assets/**.css"), handler());
+    tree.freeze();
+
+    std::size_t allocationsBefore = heapAllocations;
+    std::size_t allowed = 0;
+    for(std::string_view path : {"/api/v1/users", "/api/v1/users/42/posts/7", "/files/a/b.txt", "/assets/css/site.css", "/missing"}){
+        allowed += tree.search(HTTP_GET, path).methodAllowed();
+    }
+    allowed += tree.search(HTTP_POST, "/api/v1/users").methodAllowed();
+    std::size_t allocations = heapAllocations - allocationsBefore;
+    check(allocations == 0, "route lookups do not allocate");
+    check(allowed == 4, "the lookups that should match the four GET routes do");
+}
+
+// A group mounted at /api covers /api and /api/users, not /apiary which only shares its text
+void testGroupMiddlewareStopsAtSegmentBoundary(){
+    Middleware groupMiddleware;
+    groupMiddleware.push(&testMiddleware);
+    groupMiddleware.pushAfter(&testAfterHook);
+    RouteGroup api("/api", groupMiddleware);
+    api.get("/users", &testHandler);
+
+    RadixTree tree;
+    tree.mount(api);
+    tree.insert(HTTP_GET, RoutePattern("/api"), handler());
+    tree.insert(HTTP_GET, RoutePattern("/apiary"), handler());
+    tree.insert(HTTP_GET, RoutePattern("/apiary/hives"), handler());
+
+    RouteMatch usersMatch = tree.search(HTTP_GET, "/api/users");
+    check(usersMatch.getMiddlewareChain().size() == 1, "GET /api/users runs the group middleware");
+    check(usersMatch.getAfterHookChain().size() == 1, "GET /api/users runs the group after hook");
+
+    RouteMatch prefixMatch = tree.search(HTTP_GET, "/api");
+    check(prefixMatch.getMiddlewareChain().size() == 1, "GET /api runs the group middleware");
+    check(prefixMatch.getAfterHookChain().size() == 1, "GET /api runs the group after hook");
+
+    RouteMatch siblingMatch = tree.search(HTTP_GET, "/apiary");
+    check(siblingMatch.methodAllowed(), "GET /apiary matches GET /apiary");
+    check(siblingMatch.getMiddlewareChain().empty(), "GET /apiary does not run the group middleware");
+    check(siblingMatch.getAfterHookChain().empty(), "GET /apiary does not run the group after hook");
+    check(tree.search(HTTP_GET, "/apiary/hives").getMiddlewareChain().empty(), "GET /apiary/hives does not run the group middleware");
+}
+
+// Middleware holding a move-only lambda is shared, not copied, when routes and groups copy it
+void testMoveOnlyMiddleware(){
+    std::unique_ptr<int> calls = std::make_unique<int>(0);
+    Middleware countingMiddleware;
+    countingMiddleware.push([calls = std::move(calls)]([[maybe_unused]] Request& req) mutable {
+        (*calls)++;
+        return Middleware::next();
+    });
+    countingMiddleware.pushAfter([owned = std::make_unique<int>(0)]([[maybe_unused]] Request& req, [[maybe_unused]] Response& res){});
+
+    RouteGroup api("/api", countingMiddleware);
+    api.get("/users", &testHandler, countingMiddleware);
+
+    RadixTree tree;
+    tree.mount(api);
+    RouteMatch usersMatch = tree.search(HTTP_GET, "/api/users");
+    check(usersMatch.getMiddlewareChain().size() == 2, "GET /api/users runs the move-only group and route middleware");
+    check(usersMatch.getAfterHookChain().size() == 2, "GET /api/users runs the move-only group and route after hooks");
+    check(usersMatch.getMiddlewareChain()[0] == usersMatch.getMiddlewareChain()[1], "copies of a Middleware share its callables");
+}
+
+int main(){
+    testStaticRouteDoesNotHideParameterRoute();
+    testStaticRouteDoesNotHideWildcardRoute();
+    testStaticRouteTableFindsTreeRoutes();
+    testRemovedStaticRouteIsNotServed();
+    testUnsupportedRegexSyntax();
+    testOverlappingPatternRoutes();
+    testRouteParamsOutliveTree();
+    testLookupsDoNotAllocate();
+    testGroupMiddlewareStopsAtSegmentBoundary();
+    testMoveOnlyMiddleware();
+
+    if(failedChecks){
+        std::cout << failedChecks << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}